@@ -450,7 +450,7 @@ void MainWindowPrivate::createContent()
     }
 #endif
 
-	for (auto DockWidget : DockManager->dockWidgetsMap())
+	for (auto DockWidget : DockManager->dockWidgetRegistry().dockWidgets())
 	{
 		_this->connect(DockWidget, SIGNAL(viewToggled(bool)), SLOT(onViewToggled(bool)));
 		_this->connect(DockWidget, SIGNAL(visibilityChanged(bool)), SLOT(onViewVisibilityChanged(bool)));
@@ -36,6 +36,9 @@
 #include <QBoxLayout>
 #include <QApplication>
 #include <QtGlobal>
+#include <QVector>
+
+#include <algorithm>
 
 #include "FloatingDockContainer.h"
 #include "DockAreaWidget.h"
@@ -59,18 +62,56 @@ struct DockAreaTabBarPrivate
 	QWidget* TabsContainerWidget;
 	QBoxLayout* TabsLayout;
 	int CurrentIndex = -1;
+	CDockWidgetTab* DraggedTab = nullptr; ///< the tab that is currently dragged
+	QVector<CDockWidgetTab*> DragTabs; ///< visible tabs in layout order
+	QVector<int> DragTabOffsets; ///< cumulative left offsets of DragTabs plus end offset
+	int DragFromSlot = -1; ///< position of the dragged tab in DragTabs
+	int DragToSlot = -1; ///< current drop position of the dragged tab in DragTabs
+	mutable QSize SizeHint; ///< cached size hint of the tabs container widget
 
 	/**
 	 * Private data constructor
 	 */
 	DockAreaTabBarPrivate(CDockAreaTabBar* _public);
 
+	/**
+	 * Takes a snapshot of the cumulative offsets of all visible tabs when
+	 * the user starts dragging the given tab
+	 */
+	void startTabDrag(CDockWidgetTab* Tab);
+
+	/**
+	 * Clears the tab drag snapshot
+	 */
+	void resetTabDrag();
+
+	/**
+	 * Returns the slot in DragTabs under the given x position of the tabs
+	 * container widget. The slot is found via binary search in the
+	 * cumulative tab offsets
+	 */
+	int dragSlotAt(int x) const;
+
+	/**
+	 * Moves the tabs between the old and the new drop slot to the position
+	 * they will have if the dragged tab is dropped into the given slot.
+	 * This only moves the affected tabs and does not relayout the tab bar
+	 */
+	void updateDragSlot(int Slot);
+
 	/**
 	 * Update tabs after current index changed or when tabs are removed.
 	 * The function reassigns the stylesheet to update the tabs
 	 */
 	void updateTabs();
 
+	/**
+	 * Recomputes the cached size hint. The geometry of the tab bar is only
+	 * updated if the size hint has changed, so that a tab change does not
+	 * relayout the dock area and its parents if the tab bar keeps its size
+	 */
+	void updateSizeHint();
+
 	/**
 	 * Convenience function to access first tab
 	 */
@@ -91,6 +132,20 @@ DockAreaTabBarPrivate::DockAreaTabBarPrivate(CDockAreaTabBar* _public) :
 }
 
 
+//============================================================================
+void DockAreaTabBarPrivate::updateSizeHint()
+{
+	auto NewSizeHint = TabsContainerWidget->sizeHint();
+	if (NewSizeHint == SizeHint)
+	{
+		return;
+	}
+
+	SizeHint = NewSizeHint;
+	_this->updateGeometry();
+}
+
+
 //============================================================================
 void DockAreaTabBarPrivate::updateTabs()
 {
@@ -117,6 +172,95 @@ void DockAreaTabBarPrivate::updateTabs()
 }
 
 
+//============================================================================
+void DockAreaTabBarPrivate::startTabDrag(CDockWidgetTab* Tab)
+{
+	resetTabDrag();
+	DraggedTab = Tab;
+	// We do not use the geometry of the tabs here because the dragged tab
+	// has already been moved away from its layout position
+	int Offset = TabsLayout->contentsMargins().left();
+	for (int i = 0; i < _this->count(); ++i)
+	{
+		auto TabWidget = _this->tab(i);
+		if (TabWidget->isHidden())
+		{
+			continue;
+		}
+
+		if (TabWidget == Tab)
+		{
+			DragFromSlot = DragTabs.count();
+		}
+		DragTabs.append(TabWidget);
+		DragTabOffsets.append(Offset);
+		Offset += TabWidget->width() + TabsLayout->spacing();
+	}
+	DragTabOffsets.append(Offset);
+	DragToSlot = DragFromSlot;
+}
+
+
+//============================================================================
+void DockAreaTabBarPrivate::resetTabDrag()
+{
+	DraggedTab = nullptr;
+	DragTabs.clear();
+	DragTabOffsets.clear();
+	DragFromSlot = -1;
+	DragToSlot = -1;
+}
+
+
+//============================================================================
+int DockAreaTabBarPrivate::dragSlotAt(int x) const
+{
+	if (DragTabs.isEmpty())
+	{
+		return -1;
+	}
+
+	auto it = std::upper_bound(DragTabOffsets.begin(), DragTabOffsets.end() - 1, x);
+	int Slot = int(it - DragTabOffsets.begin()) - 1;
+	return qBound(0, Slot, DragTabs.count() - 1);
+}
+
+
+//============================================================================
+void DockAreaTabBarPrivate::updateDragSlot(int Slot)
+{
+	if (Slot < 0 || Slot == DragToSlot || DragFromSlot < 0)
+	{
+		return;
+	}
+
+	int First = qMin(Slot, DragToSlot);
+	int Last = qMax(Slot, DragToSlot);
+	int Shift = DraggedTab->width() + TabsLayout->spacing();
+	DragToSlot = Slot;
+	for (int i = First; i <= Last; ++i)
+	{
+		if (i == DragFromSlot)
+		{
+			continue;
+		}
+
+		// All tabs between the start slot and the drop slot make room for
+		// the dragged tab
+		int x = DragTabOffsets[i];
+		if (DragFromSlot < i && i <= DragToSlot)
+		{
+			x -= Shift;
+		}
+		else if (DragToSlot <= i && i < DragFromSlot)
+		{
+			x += Shift;
+		}
+		DragTabs[i]->move(x, DragTabs[i]->y());
+	}
+}
+
+
 //============================================================================
 CDockAreaTabBar::CDockAreaTabBar(CDockAreaWidget* parent) :
 	QScrollArea(parent),
@@ -183,7 +327,7 @@ void CDockAreaTabBar::setCurrentIndex(int index)
     emit currentChanging(index);
 	d->CurrentIndex = index;
 	d->updateTabs();
-	updateGeometry();
+	d->updateSizeHint();
 	emit currentChanged(index);
 }
 
@@ -199,10 +343,12 @@ int CDockAreaTabBar::count() const
 //===========================================================================
 void CDockAreaTabBar::insertTab(int Index, CDockWidgetTab* Tab)
 {
+	d->resetTabDrag();
 	d->TabsLayout->insertWidget(Index, Tab);
 	connect(Tab, SIGNAL(clicked()), this, SLOT(onTabClicked()));
 	connect(Tab, SIGNAL(closeRequested()), this, SLOT(onTabCloseRequested()));
 	connect(Tab, SIGNAL(closeOtherTabsRequested()), this, SLOT(onCloseOtherTabsRequested()));
+	connect(Tab, SIGNAL(moving(const QPoint&)), this, SLOT(onTabWidgetMoving(const QPoint&)));
 	connect(Tab, SIGNAL(moved(const QPoint&)), this, SLOT(onTabWidgetMoved(const QPoint&)));
 	connect(Tab, SIGNAL(elidedChanged(bool)), this, SIGNAL(elidedChanged(bool)));
 	Tab->installEventFilter(this);
@@ -216,7 +362,7 @@ void CDockAreaTabBar::insertTab(int Index, CDockWidgetTab* Tab)
     	setCurrentIndex(Index);
     }
 
-	updateGeometry();
+	d->updateSizeHint();
 }
 
 
@@ -267,6 +413,7 @@ void CDockAreaTabBar::removeTab(CDockWidgetTab* Tab)
 	}
 
 	emit removingTab(RemoveIndex);
+	d->resetTabDrag();
 	d->TabsLayout->removeWidget(Tab);
 	Tab->disconnect(this);
 	Tab->removeEventFilter(this);
@@ -280,7 +427,7 @@ void CDockAreaTabBar::removeTab(CDockWidgetTab* Tab)
 		d->updateTabs();
 	}
 
-	updateGeometry();
+	d->updateSizeHint();
 }
 
 
@@ -372,6 +519,25 @@ CDockWidgetTab* CDockAreaTabBar::tab(int Index) const
 }
 
 
+//===========================================================================
+void CDockAreaTabBar::onTabWidgetMoving(const QPoint& GlobalPos)
+{
+	CDockWidgetTab* MovingTab = qobject_cast<CDockWidgetTab*>(sender());
+	if (!MovingTab)
+	{
+		return;
+	}
+
+	if (d->DraggedTab != MovingTab)
+	{
+		d->startTabDrag(MovingTab);
+	}
+
+	auto MousePos = d->TabsContainerWidget->mapFromGlobal(GlobalPos);
+	d->updateDragSlot(d->dragSlotAt(MousePos.x()));
+}
+
+
 //===========================================================================
 void CDockAreaTabBar::onTabWidgetMoved(const QPoint& GlobalPos)
 {
@@ -381,29 +547,23 @@ void CDockAreaTabBar::onTabWidgetMoved(const QPoint& GlobalPos)
 		return;
 	}
 
+	if (d->DraggedTab != MovingTab)
+	{
+		d->startTabDrag(MovingTab);
+	}
+
 	int fromIndex = d->TabsLayout->indexOf(MovingTab);
-	auto MousePos = mapFromGlobal(GlobalPos);
-	MousePos.rx() = qMax(d->firstTab()->geometry().left(), MousePos.x());
-	MousePos.rx() = qMin(d->lastTab()->geometry().right(), MousePos.x());
+	auto MousePos = d->TabsContainerWidget->mapFromGlobal(GlobalPos);
+	int ToSlot = d->dragSlotAt(MousePos.x());
 	int toIndex = -1;
-	// Find tab under mouse
-	for (int i = 0; i < count(); ++i)
+	if (ToSlot >= 0 && ToSlot != d->DragFromSlot)
 	{
-		CDockWidgetTab* DropTab = tab(i);
-		if (DropTab == MovingTab || !DropTab->isVisibleTo(this)
-		    || !DropTab->geometry().contains(MousePos))
-		{
-			continue;
-		}
-
-		toIndex = d->TabsLayout->indexOf(DropTab);
-		if (toIndex == fromIndex)
-		{
-			toIndex = -1;
-		}
-		break;
+		toIndex = d->TabsLayout->indexOf(d->DragTabs[ToSlot]);
 	}
+	d->resetTabDrag();
 
+	// The tabs have only been moved visually while dragging. Now we commit
+	// the new order to the layout once
 	if (toIndex > -1)
 	{
 		d->TabsLayout->removeWidget(MovingTab);
@@ -440,6 +600,15 @@ void CDockAreaTabBar::closeTab(int Index)
 bool CDockAreaTabBar::eventFilter(QObject *watched, QEvent *event)
 {
 	bool Result = Super::eventFilter(watched, event);
+	// The scroll area installs this event filter on the tabs container widget.
+	// A layout request of the container means, that a tab has been resized,
+	// shown or hidden
+	if (watched == d->TabsContainerWidget && event->type() == QEvent::LayoutRequest)
+	{
+		d->updateSizeHint();
+		return Result;
+	}
+
 	CDockWidgetTab* Tab = qobject_cast<CDockWidgetTab*>(watched);
 	if (!Tab)
 	{
@@ -448,19 +617,25 @@ bool CDockAreaTabBar::eventFilter(QObject *watched, QEvent *event)
 
 	switch (event->type())
 	{
+	// A new tab drag may start - the offsets of the last drag are outdated
+	case QEvent::MouseButtonPress:
+		 d->resetTabDrag();
+		 break;
+
 	case QEvent::Hide:
 		 emit tabClosed(d->TabsLayout->indexOf(Tab));
-		 updateGeometry();
+		 d->updateSizeHint();
 		 break;
 
 	case QEvent::Show:
 		 emit tabOpened(d->TabsLayout->indexOf(Tab));
-		 updateGeometry();
+		 d->updateSizeHint();
 		 break;
 
     // Setting the text of a tab will cause a LayoutRequest event
     case QEvent::LayoutRequest:
-         updateGeometry();
+         d->resetTabDrag();
+         d->updateSizeHint();
          break;
 
 	default:
@@ -495,7 +670,11 @@ QSize CDockAreaTabBar::minimumSizeHint() const
 //===========================================================================
 QSize CDockAreaTabBar::sizeHint() const
 {
-	return d->TabsContainerWidget->sizeHint();
+	if (!d->SizeHint.isValid())
+	{
+		d->SizeHint = d->TabsContainerWidget->sizeHint();
+	}
+	return d->SizeHint;
 }
 
 } // namespace ads
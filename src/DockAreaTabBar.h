@@ -62,6 +62,7 @@ private slots:
 	void onTabClicked();
 	void onTabCloseRequested();
 	void onCloseOtherTabsRequested();
+	void onTabWidgetMoving(const QPoint& GlobalPos);
 	void onTabWidgetMoved(const QPoint& GlobalPos);
 
 protected:
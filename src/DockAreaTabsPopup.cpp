@@ -0,0 +1,315 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockAreaTabsPopup.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CDockAreaTabsModel and CDockAreaTabsPopup classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockAreaTabsPopup.h"
+
+#include <QLineEdit>
+#include <QListView>
+#include <QSortFilterProxyModel>
+#include <QVector>
+
+#include "DockAreaTabBar.h"
+#include "DockWidgetTab.h"
+#include "DockWidget.h"
+
+namespace ads
+{
+/**
+ * Filter proxy that hides closed tabs and filters the remaining tabs by
+ * the text entered into the popup line edit
+ */
+class CTabsFilterProxyModel : public QSortFilterProxyModel
+{
+public:
+	using QSortFilterProxyModel::QSortFilterProxyModel;
+
+protected:
+	virtual bool filterAcceptsRow(int SourceRow, const QModelIndex& SourceParent) const override
+	{
+		auto Index = sourceModel()->index(SourceRow, 0, SourceParent);
+		if (!Index.data(CDockAreaTabsModel::TabOpenRole).toBool())
+		{
+			return false;
+		}
+		return QSortFilterProxyModel::filterAcceptsRow(SourceRow, SourceParent);
+	}
+};
+
+
+/**
+ * Private data class of CDockAreaTabsModel class (pimpl)
+ */
+struct DockAreaTabsModelPrivate
+{
+	CDockAreaTabsModel* _this;
+	CDockAreaTabBar* TabBar;
+	QVector<CDockWidgetTab*> Tabs;
+
+	/**
+	 * Private data constructor
+	 */
+	DockAreaTabsModelPrivate(CDockAreaTabsModel* _public) : _this(_public) {}
+
+	/**
+	 * Connects the title change signal of the dock widget of the given tab
+	 */
+	void connectTab(CDockWidgetTab* Tab);
+};
+// struct DockAreaTabsModelPrivate
+
+
+//============================================================================
+void DockAreaTabsModelPrivate::connectTab(CDockWidgetTab* Tab)
+{
+	if (Tab && Tab->dockWidget())
+	{
+		QObject::connect(Tab->dockWidget(), SIGNAL(titleChanged(const QString&)),
+			_this, SLOT(onDockWidgetTitleChanged()), Qt::UniqueConnection);
+	}
+}
+
+
+//============================================================================
+CDockAreaTabsModel::CDockAreaTabsModel(CDockAreaTabBar* TabBar, QObject* Parent) :
+	Super(Parent),
+	d(new DockAreaTabsModelPrivate(this))
+{
+	d->TabBar = TabBar;
+	d->Tabs.reserve(TabBar->count());
+	for (int i = 0; i < TabBar->count(); ++i)
+	{
+		auto Tab = TabBar->tab(i);
+		d->Tabs.append(Tab);
+		d->connectTab(Tab);
+	}
+
+	connect(TabBar, SIGNAL(tabInserted(int)), SLOT(onTabInserted(int)));
+	connect(TabBar, SIGNAL(removingTab(int)), SLOT(onRemovingTab(int)));
+	connect(TabBar, SIGNAL(tabMoved(int, int)), SLOT(onTabMoved(int, int)));
+	connect(TabBar, SIGNAL(tabOpened(int)), SLOT(onTabOpenStateChanged(int)));
+	connect(TabBar, SIGNAL(tabClosed(int)), SLOT(onTabOpenStateChanged(int)));
+}
+
+
+//============================================================================
+CDockAreaTabsModel::~CDockAreaTabsModel()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CDockAreaTabsModel::onTabInserted(int Index)
+{
+	if (Index < 0 || Index > d->Tabs.count())
+	{
+		return;
+	}
+
+	auto Tab = d->TabBar->tab(Index);
+	beginInsertRows(QModelIndex(), Index, Index);
+	d->Tabs.insert(Index, Tab);
+	endInsertRows();
+	d->connectTab(Tab);
+}
+
+
+//============================================================================
+void CDockAreaTabsModel::onRemovingTab(int Index)
+{
+	if (Index < 0 || Index >= d->Tabs.count())
+	{
+		return;
+	}
+
+	auto Tab = d->Tabs[Index];
+	beginRemoveRows(QModelIndex(), Index, Index);
+	d->Tabs.remove(Index);
+	endRemoveRows();
+	if (Tab && Tab->dockWidget())
+	{
+		Tab->dockWidget()->disconnect(this);
+	}
+}
+
+
+//============================================================================
+void CDockAreaTabsModel::onTabMoved(int From, int To)
+{
+	if (From == To || From < 0 || To < 0 || From >= d->Tabs.count()
+	 || To >= d->Tabs.count())
+	{
+		return;
+	}
+
+	// For moves to a higher index, the destination row given to beginMoveRows
+	// is the row before which the moved row will be inserted
+	beginMoveRows(QModelIndex(), From, From, QModelIndex(), (To > From) ? (To + 1) : To);
+	d->Tabs.move(From, To);
+	endMoveRows();
+}
+
+
+//============================================================================
+void CDockAreaTabsModel::onTabOpenStateChanged(int Index)
+{
+	if (Index < 0 || Index >= d->Tabs.count())
+	{
+		return;
+	}
+
+	auto ModelIndex = index(Index);
+	emit dataChanged(ModelIndex, ModelIndex, {TabOpenRole});
+}
+
+
+//============================================================================
+void CDockAreaTabsModel::onDockWidgetTitleChanged()
+{
+	auto DockWidget = qobject_cast<CDockWidget*>(sender());
+	if (!DockWidget)
+	{
+		return;
+	}
+
+	int Row = d->Tabs.indexOf(DockWidget->tabWidget());
+	if (Row < 0)
+	{
+		return;
+	}
+
+	auto ModelIndex = index(Row);
+	emit dataChanged(ModelIndex, ModelIndex, {Qt::DisplayRole, Qt::ToolTipRole});
+}
+
+
+//============================================================================
+CDockWidgetTab* CDockAreaTabsModel::tab(int Row) const
+{
+	return (Row >= 0 && Row < d->Tabs.count()) ? d->Tabs[Row] : nullptr;
+}
+
+
+//============================================================================
+int CDockAreaTabsModel::rowCount(const QModelIndex& Parent) const
+{
+	return Parent.isValid() ? 0 : d->Tabs.count();
+}
+
+
+//============================================================================
+QVariant CDockAreaTabsModel::data(const QModelIndex& Index, int Role) const
+{
+	auto Tab = tab(Index.row());
+	if (!Index.isValid() || !Tab)
+	{
+		return QVariant();
+	}
+
+	switch (Role)
+	{
+	case Qt::DisplayRole: return Tab->text();
+	case Qt::DecorationRole: return Tab->icon();
+	case Qt::ToolTipRole: return Tab->toolTip();
+	case TabIndexRole: return Index.row();
+	case TabOpenRole: return !Tab->isHidden();
+	default:
+		return QVariant();
+	}
+}
+
+
+/**
+ * Private data class of CDockAreaTabsPopup class (pimpl)
+ */
+struct DockAreaTabsPopupPrivate
+{
+	CDockAreaTabsPopup* _this;
+	CDockAreaTabBar* TabBar;
+	CDockAreaTabsModel* Model;
+
+	/**
+	 * Private data constructor
+	 */
+	DockAreaTabsPopupPrivate(CDockAreaTabsPopup* _public) : _this(_public) {}
+};
+// struct DockAreaTabsPopupPrivate
+
+
+//============================================================================
+CDockAreaTabsPopup::CDockAreaTabsPopup(CDockAreaTabBar* TabBar, QWidget* Parent) :
+	Super(new CTabsFilterProxyModel(), Parent),
+	d(new DockAreaTabsPopupPrivate(this))
+{
+	setObjectName("dockAreaTabsPopup");
+	filterEdit()->setObjectName("tabsPopupFilterEdit");
+	filterEdit()->setPlaceholderText(tr("Filter tabs"));
+	listView()->setObjectName("tabsPopupListView");
+	d->TabBar = TabBar;
+	d->Model = new CDockAreaTabsModel(TabBar, this);
+	proxyModel()->setSourceModel(d->Model);
+}
+
+
+//============================================================================
+CDockAreaTabsPopup::~CDockAreaTabsPopup()
+{
+	delete d;
+}
+
+
+//============================================================================
+CDockAreaTabsModel* CDockAreaTabsPopup::model() const
+{
+	return d->Model;
+}
+
+
+//============================================================================
+void CDockAreaTabsPopup::popup(const QPoint& GlobalPos)
+{
+	// Icons and tool tips are neither cached by the model nor by the view.
+	// The view queries them for the visible rows when the popup is painted,
+	// so no row needs to be refreshed here.
+	// The top right corner of the popup is placed at the given position
+	int Width = qMax(d->TabBar->width(), 250);
+	showPopup(QPoint(GlobalPos.x() - Width + 1, GlobalPos.y() + 1), Width, 15,
+		d->Model->index(d->TabBar->currentIndex()));
+}
+
+
+//============================================================================
+void CDockAreaTabsPopup::activateRow(int SourceRow)
+{
+	emit tabActivated(SourceRow);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockAreaTabsPopup.cpp
@@ -0,0 +1,152 @@
+#ifndef DockAreaTabsPopupH
+#define DockAreaTabsPopupH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockAreaTabsPopup.h
+/// \date   18.10.2026
+/// \brief  Declaration of CDockAreaTabsModel and CDockAreaTabsPopup classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QAbstractListModel>
+
+#include "FilterPopup.h"
+
+namespace ads
+{
+class CDockAreaTabBar;
+class CDockWidgetTab;
+struct DockAreaTabsModelPrivate;
+struct DockAreaTabsPopupPrivate;
+
+/**
+ * Lightweight list model over the tabs of a dock area tab bar.
+ * The model does not copy any tab data. It keeps a list of tab pointers
+ * that is updated incrementally from the tab bar signals and queries text,
+ * icon and tool tip from the tab when a view asks for it. So only the rows
+ * that are visible in a view are ever queried.
+ */
+class ADS_EXPORT CDockAreaTabsModel : public QAbstractListModel
+{
+	Q_OBJECT
+private:
+	DockAreaTabsModelPrivate* d; ///< private data (pimpl)
+	friend struct DockAreaTabsModelPrivate;
+
+private slots:
+	void onTabInserted(int Index);
+	void onRemovingTab(int Index);
+	void onTabMoved(int From, int To);
+	void onTabOpenStateChanged(int Index);
+	void onDockWidgetTitleChanged();
+
+public:
+	using Super = QAbstractListModel;
+
+	/**
+	 * Custom item data roles
+	 */
+	enum eRole
+	{
+		TabIndexRole = Qt::UserRole + 1, ///< index of the tab in the tab bar
+		TabOpenRole  ///< true, if the tab is open (not closed / hidden)
+	};
+
+	/**
+	 * Creates a model for the given tab bar
+	 */
+	CDockAreaTabsModel(CDockAreaTabBar* TabBar, QObject* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockAreaTabsModel();
+
+	/**
+	 * Returns the tab for the given row or a nullptr if the row is invalid
+	 */
+	CDockWidgetTab* tab(int Row) const;
+
+public: // reimplements QAbstractListModel ------------------------------------
+	virtual int rowCount(const QModelIndex& Parent = QModelIndex()) const override;
+	virtual QVariant data(const QModelIndex& Index, int Role = Qt::DisplayRole) const override;
+}; // class CDockAreaTabsModel
+
+
+/**
+ * Searchable popup that lists all open tabs of a dock area.
+ * The popup is an alternative to the tabs menu of the dock area title bar
+ * and is used if the CDockManager::DockAreaHasSearchableTabsMenu flag is
+ * set. It shows a filter line edit on top of a list view with uniform item
+ * sizes. The popup is created once per title bar and reused, so opening it
+ * costs the same for 5 or for 500 tabs.
+ */
+class ADS_EXPORT CDockAreaTabsPopup : public CFilterPopup
+{
+	Q_OBJECT
+private:
+	DockAreaTabsPopupPrivate* d; ///< private data (pimpl)
+	friend struct DockAreaTabsPopupPrivate;
+
+protected:
+	/**
+	 * Emits tabActivated() for the tab of the given row
+	 */
+	virtual void activateRow(int SourceRow) override;
+
+public:
+	using Super = CFilterPopup;
+
+	/**
+	 * Creates a popup for the given tab bar
+	 */
+	CDockAreaTabsPopup(CDockAreaTabBar* TabBar, QWidget* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockAreaTabsPopup();
+
+	/**
+	 * Returns the model that backs the popup list
+	 */
+	CDockAreaTabsModel* model() const;
+
+	/**
+	 * Clears the filter, selects the current tab and shows the popup with its
+	 * top right corner at the given global position
+	 */
+	void popup(const QPoint& GlobalPos);
+
+signals:
+	/**
+	 * This signal is emitted if the user activates the tab with the given
+	 * tab bar index
+	 */
+	void tabActivated(int Index);
+}; // class CDockAreaTabsPopup
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // DockAreaTabsPopupH
@@ -49,8 +49,11 @@
 #include "DockWidget.h"
 #include "DockWidgetTab.h"
 #include "DockAreaTabBar.h"
+#include "DockAreaTabsPopup.h"
 #include "IconProvider.h"
 #include "DockComponentsFactory.h"
+#include "DockGroupMenu.h"
+#include "DockStyle.h"
 
 #include <iostream>
 
@@ -80,7 +83,9 @@ struct DockAreaTitleBarPrivate
 	CDockAreaTabBar* TabBar;
 	bool MenuOutdated = true;
 	QMenu* TabsMenu;
+	CDockAreaTabsPopup* TabsPopup = nullptr;
 	QList<tTitleBarButton*> DockWidgetActionsButtons;
+	QPointer<QMenu> GroupWidgetsMenu;
 
 	QPoint DragStartMousePos;
 	eDragState DragState = DraggingInactive;
@@ -103,9 +108,10 @@ struct DockAreaTitleBarPrivate
 	void createTabBar();
 
     /**
-     * Creates menu with close and detach actions
+     * Creates menu with close and detach actions.
+     * If WidgetsMenu is given, it is added as first sub menu
      */
-    QMenu *createGenaralGroupMenu(QWidget *parent);
+    QMenu *createGenaralGroupMenu(QWidget *parent, QMenu *WidgetsMenu = nullptr);
 
 	/**
 	 * Convenience function for DockManager access
@@ -174,17 +180,26 @@ void DockAreaTitleBarPrivate::createButtons()
 	TabsMenuButton->setAutoRaise(true);
 	TabsMenuButton->setPopupMode(QToolButton::InstantPopup);
 	internal::setButtonIcon(TabsMenuButton, QStyle::SP_TitleBarUnshadeButton, ads::DockAreaMenuIcon);
-	QMenu* TabsMenu = new QMenu(TabsMenuButton);
+	if (testConfigFlag(CDockManager::DockAreaHasSearchableTabsMenu))
+	{
+		// The searchable popup is created on first use and replaces the
+		// tabs menu that is rebuilt completely each time it is outdated
+		_this->connect(TabsMenuButton, SIGNAL(clicked()), SLOT(showTabsPopup()));
+	}
+	else
+	{
+		QMenu* TabsMenu = new QMenu(TabsMenuButton);
 #ifndef QT_NO_TOOLTIP
-	TabsMenu->setToolTipsVisible(true);
+		TabsMenu->setToolTipsVisible(true);
 #endif
-	_this->connect(TabsMenu, SIGNAL(aboutToShow()), SLOT(onTabsMenuAboutToShow()));
-	TabsMenuButton->setMenu(TabsMenu);
+		_this->connect(TabsMenu, SIGNAL(aboutToShow()), SLOT(onTabsMenuAboutToShow()));
+		TabsMenuButton->setMenu(TabsMenu);
+		_this->connect(TabsMenuButton->menu(), SIGNAL(triggered(QAction*)),
+			SLOT(onTabsMenuActionTriggered(QAction*)));
+	}
 	internal::setToolTip(TabsMenuButton, QObject::tr("List All Tabs"));
     TabsMenuButton->setFixedSize(buttonSize);
     buttonsContainerLayout->addWidget(TabsMenuButton, 0);
-	_this->connect(TabsMenuButton->menu(), SIGNAL(triggered(QAction*)),
-        SLOT(onTabsMenuActionTriggered(QAction*)));
 
     if (testConfigFlag(CDockManager::DockAreaHasGroupMenuButton)) {
         CDockManager::setConfigFlag(CDockManager::DockAreaHasUndockButton, false);
@@ -250,9 +265,19 @@ void DockAreaTitleBarPrivate::createTabBar()
 
 
 //============================================================================
-QMenu *DockAreaTitleBarPrivate::createGenaralGroupMenu(QWidget *parent)
+QMenu *DockAreaTitleBarPrivate::createGenaralGroupMenu(QWidget *parent, QMenu *WidgetsMenu)
 {
     QMenu *menu = new QMenu(parent);
+    if (WidgetsMenu) {
+        WidgetsMenu->setTitle(QObject::tr("Insert widget"));
+        menu->addMenu(WidgetsMenu);
+        menu->addSeparator();
+        // The widgets menu is shared by all dock areas - the area that
+        // shows it becomes the target of the inserted widgets
+        _this->connect(menu, &QMenu::aboutToShow, [=]() {
+            dockManager()->groupMenu()->setTargetArea(DockArea);
+        });
+    }
     auto *detachAct = menu->addAction("Detach Group");
     auto *closeAct = menu->addAction("Close Group");
     _this->connect(detachAct, &QAction::triggered, [=](bool) {
@@ -276,7 +301,7 @@ IFloatingWidget* DockAreaTitleBarPrivate::makeAreaFloating(const QPoint& Offset,
 	IFloatingWidget* FloatingWidget;
 	if (OpaqueUndocking)
 	{
-		FloatingWidget = FloatingDockContainer = new CFloatingDockContainer(DockArea);
+		FloatingWidget = FloatingDockContainer = CFloatingDockContainer::createFloatingWidget(DockArea);
 	}
 	else
 	{
@@ -327,6 +352,7 @@ CDockAreaTitleBar::CDockAreaTitleBar(CDockAreaWidget* parent) :
 	d->createButtons();
 
     setFocusPolicy(Qt::NoFocus);
+	CDockStyle::applyTo(this, true);
 }
 
 
@@ -412,6 +438,28 @@ void CDockAreaTitleBar::onTabsMenuAboutToShow()
 }
 
 
+//============================================================================
+void CDockAreaTitleBar::showTabsPopup()
+{
+	if (!d->TabsPopup)
+	{
+		d->TabsPopup = new CDockAreaTabsPopup(d->TabBar, this);
+		connect(d->TabsPopup, SIGNAL(tabActivated(int)), SLOT(onTabsPopupTabActivated(int)));
+	}
+
+	d->TabsPopup->popup(d->TabsMenuButton->mapToGlobal(
+		d->TabsMenuButton->rect().bottomRight()));
+}
+
+
+//============================================================================
+void CDockAreaTitleBar::onTabsPopupTabActivated(int Index)
+{
+	d->TabBar->setCurrentIndex(Index);
+	emit tabBarClicked(Index);
+}
+
+
 //============================================================================
 void CDockAreaTitleBar::onCloseButtonClicked()
 {
@@ -525,25 +573,26 @@ void CDockAreaTitleBar::setVisible(bool Visible)
 
 void CDockAreaTitleBar::setGroupMenu(QMenu *widgetsMenu)
 {
-    if (d->GroupButton) {
-        auto oldMenu = d->GroupButton->menu();
-        bool needOpen = false;
-        if (oldMenu) {
-            needOpen = oldMenu->isVisible();
-            oldMenu->close();
-            auto list = oldMenu->actions();
-            qDeleteAll(list);
-            oldMenu->deleteLater();
-        }
-        auto *menu = new QMenu(d->GroupButton);
-        widgetsMenu->setTitle(tr("Insert widget"));
-        menu->addMenu(widgetsMenu);
-        menu->addSeparator();
-        menu->addActions(d->createGenaralGroupMenu(d->GroupButton)->actions());
-        d->GroupButton->setMenu(menu);
-        if (needOpen) {
-            d->GroupButton->showMenu();
+    if (!d->GroupButton || d->GroupWidgetsMenu == widgetsMenu) {
+        return;
+    }
+
+    // The widgets menu is persistent, so the button menu is only created
+    // again if a different widgets menu is set
+    auto oldMenu = d->GroupButton->menu();
+    bool needOpen = false;
+    if (oldMenu) {
+        needOpen = oldMenu->isVisible();
+        oldMenu->close();
+        if (d->GroupWidgetsMenu) {
+            oldMenu->removeAction(d->GroupWidgetsMenu->menuAction());
         }
+        oldMenu->deleteLater();
+    }
+    d->GroupWidgetsMenu = widgetsMenu;
+    d->GroupButton->setMenu(d->createGenaralGroupMenu(d->GroupButton, widgetsMenu));
+    if (needOpen) {
+        d->GroupButton->showMenu();
     }
 }
 
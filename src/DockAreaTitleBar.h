@@ -61,6 +61,7 @@ private slots:
 	void onUndockButtonClicked();
 	void onTabsMenuActionTriggered(QAction* Action);
 	void onCurrentTabChanged(int Index);
+	void onTabsPopupTabActivated(int Index);
 
 protected:
 		/**
@@ -96,6 +97,12 @@ public slots:
 	 */
 	void markTabsMenuOutdated();
 
+	/**
+	 * Shows the searchable tabs popup below the tabs menu button.
+	 * The tabs menu button calls this slot if the
+	 * CDockManager::DockAreaHasSearchableTabsMenu flag is set.
+	 */
+	void showTabsPopup();
 
 public:
 	using Super = QFrame;
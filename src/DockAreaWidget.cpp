@@ -42,6 +42,10 @@
 #include <QXmlStreamWriter>
 #include <QVector>
 #include <QList>
+#include <QPointer>
+#include <QLabel>
+#include <QPixmap>
+#include <QTimer>
 
 
 #include "DockContainerWidget.h"
@@ -55,6 +59,7 @@
 #include "DockComponentsFactory.h"
 #include "DockWidgetTab.h"
 #include "DockGroupMenu.h"
+#include "DockStyle.h"
 
 #define RE_LOG_ENABLE
 //#define RE_LOG_DEBUG_ENABLE
@@ -65,8 +70,6 @@
 
 namespace ads
 {
-static const char* const INDEX_PROPERTY = "index";
-static const char* const ACTION_PROPERTY = "action";
 
 /**
  * Internal dock area layout mimics stack layout but only inserts the current
@@ -74,6 +77,10 @@ static const char* const ACTION_PROPERTY = "action";
  * \warning Only the current widget has a parent. All other widgets
  * do not have a parent. That means, a widget that is in this layout may
  * return nullptr for its parent() function if it is not the current widget.
+ * If the CDockManager::StackedDockAreaContent performance flag is set, all
+ * widgets are parented to the dock area like in a QStackedLayout and only
+ * the hidden state changes on a tab switch. This avoids the recreation of
+ * native child windows and OpenGL contexts of the tab content.
  */
 class CDockAreaLayout
 {
@@ -82,13 +89,15 @@ private:
 	QList<QWidget*> m_Widgets;
 	int m_CurrentIndex = -1;
 	QWidget* m_CurrentWidget = nullptr;
+	bool m_Stacked = false;
 
 public:
 	/**
 	 * Creates an instance with the given parent layout
 	 */
 	CDockAreaLayout(QBoxLayout* ParentLayout)
-		: m_ParentLayout(ParentLayout)
+		: m_ParentLayout(ParentLayout),
+		  m_Stacked(CDockManager::testPerformanceFlag(CDockManager::StackedDockAreaContent))
 	{
 
 	}
@@ -107,7 +116,14 @@ public:
 	 */
 	void insertWidget(int index, QWidget* Widget)
 	{
-		Widget->setParent(nullptr);
+		if (m_Stacked)
+		{
+			Widget->setParent(m_ParentLayout->parentWidget());
+		}
+		else
+		{
+			Widget->setParent(nullptr);
+		}
 		if (index < 0)
 		{
 			index = m_Widgets.count();
@@ -119,6 +135,10 @@ public:
 		}
 		else
 		{
+			if (m_Stacked)
+			{
+				Widget->hide();
+			}
 			if (index <= m_CurrentIndex )
 			{
 				++m_CurrentIndex;
@@ -126,6 +146,17 @@ public:
 		}
 	}
 
+	/**
+	 * Takes the layout item of the current widget from the parent layout.
+	 * The dock area title bar may be created after the content, so the index
+	 * of the current widget in the parent layout is not fixed
+	 */
+	QLayoutItem* takeCurrentItem()
+	{
+		int Index = m_CurrentWidget ? m_ParentLayout->indexOf(m_CurrentWidget) : -1;
+		return (Index < 0) ? nullptr : m_ParentLayout->takeAt(Index);
+	}
+
 	/**
 	 * Removes the given widget from the layout
 	 */
@@ -133,7 +164,7 @@ public:
 	{
 		if (currentWidget() == Widget)
 		{
-			auto LayoutItem = m_ParentLayout->takeAt(1);
+			auto LayoutItem = takeCurrentItem();
 			if (LayoutItem)
 			{
 				LayoutItem->widget()->setParent(nullptr);
@@ -141,9 +172,18 @@ public:
 			m_CurrentWidget = nullptr;
 			m_CurrentIndex = -1;
 		}
-		else if (indexOf(Widget) < m_CurrentIndex)
+		else
 		{
-			--m_CurrentIndex;
+			// Hidden widgets keep the unparented state of the default mode
+			// when they leave the layout
+			if (m_Stacked)
+			{
+				Widget->setParent(nullptr);
+			}
+			if (indexOf(Widget) < m_CurrentIndex)
+			{
+				--m_CurrentIndex;
+			}
 		}
 		m_Widgets.removeOne(Widget);
 	}
@@ -177,15 +217,17 @@ public:
 			parent->setUpdatesEnabled(false);
 		}
 
-		auto LayoutItem = m_ParentLayout->takeAt(1);
-		if (LayoutItem)
+		auto LayoutItem = takeCurrentItem();
+		if (LayoutItem && !m_Stacked)
 		{
 			LayoutItem->widget()->setParent(nullptr);
 		}
 		delete LayoutItem;
 
+		// In stacked mode next is already a child of the dock area, so
+		// adding it to the layout only assigns its geometry
 		m_ParentLayout->addWidget(next);
-		if (prev)
+		if (prev && prev != next)
 		{
 			prev->hide();
 		}
@@ -256,6 +298,9 @@ struct DockAreaWidgetPrivate
 	DockAreaLayout*		ContentsLayout	= nullptr;
 	CDockAreaTitleBar*	TitleBar		= nullptr;
 	CDockManager*		DockManager		= nullptr;
+	QPointer<CDockContainerWidget> DockContainer;
+	QPointer<CDockWidget> RestoredCurrentDockWidget;
+	QLabel*				ContentSnapshot	= nullptr;
 	bool UpdateTitleBarButtons = false;
 	DockWidgetAreas		AllowedAreas	= DefaultAllowedAreas;
 	QSize MinSizeHint;
@@ -267,41 +312,46 @@ struct DockAreaWidgetPrivate
 	DockAreaWidgetPrivate(CDockAreaWidget* _public);
 
 	/**
-	 * Creates the layout for top area with tabs and close button
+	 * Stores a snapshot of the given visible content widget in the snapshot
+	 * cache of the dock manager
 	 */
-	void createTitleBar();
+	void captureContentSnapshot(QWidget* Widget);
 
 	/**
-	 * Returns the dock widget with the given index
+	 * Shows the cached snapshot of the given widget on top of the content
+	 * rectangle until the next event loop iteration. The snapshot is only
+	 * shown if its size matches the given rectangle
 	 */
-	CDockWidget* dockWidgetAt(int index)
-	{
-		return qobject_cast<CDockWidget*>(ContentsLayout->widget(index));
-	}
+	void showContentSnapshot(QWidget* Widget, const QRect& Rect);
 
 	/**
-	 * Convenience function to ease title widget access by index
+	 * Creates the layout for top area with tabs and close button.
+	 * If dock widgets have been inserted before, their tabs are inserted
+	 * into the new tab bar
 	 */
-	CDockWidgetTab* tabWidgetAt(int index)
-	{
-		return dockWidgetAt(index)->tabWidget();
-	}
+	void createTitleBar();
 
+	/**
+	 * Returns true, if the creation of the title bar can be deferred.
+	 * This is the case for dock areas in floating widgets if the
+	 * CDockManager::LightweightFloatingWidgets performance flag is set
+	 */
+	bool canDeferTitleBar() const;
 
 	/**
-	 * Returns the tab action of the given dock widget
+	 * Returns the dock widget with the given index
 	 */
-	QAction* dockWidgetTabAction(CDockWidget* DockWidget) const
+	CDockWidget* dockWidgetAt(int index)
 	{
-		return qvariant_cast<QAction*>(DockWidget->property(ACTION_PROPERTY));
+		return qobject_cast<CDockWidget*>(ContentsLayout->widget(index));
 	}
 
 	/**
-	 * Returns the index of the given dock widget
+	 * Convenience function to ease title widget access by index
 	 */
-	int dockWidgetIndex(CDockWidget* DockWidget) const
+	CDockWidgetTab* tabWidgetAt(int index)
 	{
-		return DockWidget->property(INDEX_PROPERTY).toInt();
+		return dockWidgetAt(index)->tabWidget();
 	}
 
 	/**
@@ -322,13 +372,20 @@ struct DockAreaWidgetPrivate
 	 */
 	void updateMinimumSizeHint()
 	{
-		MinSizeHint = QSize();
+		QSize NewSizeHint;
 		for (int i = 0; i < ContentsLayout->count(); ++i)
 		{
 			auto Widget = ContentsLayout->widget(i);
-			MinSizeHint.setHeight(qMax(MinSizeHint.height(), Widget->minimumSizeHint().height()));
-			MinSizeHint.setWidth(qMax(MinSizeHint.width(), Widget->minimumSizeHint().width()));
+			NewSizeHint.setHeight(qMax(NewSizeHint.height(), Widget->minimumSizeHint().height()));
+			NewSizeHint.setWidth(qMax(NewSizeHint.width(), Widget->minimumSizeHint().width()));
 		}
+
+		if (NewSizeHint == MinSizeHint)
+		{
+			return;
+		}
+		MinSizeHint = NewSizeHint;
+		_this->updateGeometry();
 	}
 };
 // struct DockAreaWidgetPrivate
@@ -346,16 +403,65 @@ DockAreaWidgetPrivate::DockAreaWidgetPrivate(CDockAreaWidget* _public) :
 void DockAreaWidgetPrivate::createTitleBar()
 {
 	TitleBar = componentsFactory()->createDockAreaTitleBar(_this);
-	Layout->addWidget(TitleBar);
+	Layout->insertWidget(0, TitleBar);
 	QObject::connect(tabBar(), &CDockAreaTabBar::tabCloseRequested, _this, &CDockAreaWidget::onTabCloseRequested);
 	QObject::connect(TitleBar, &CDockAreaTitleBar::tabBarClicked, _this, &CDockAreaWidget::setCurrentIndex);
 	QObject::connect(tabBar(), &CDockAreaTabBar::tabMoved, _this, &CDockAreaWidget::reorderDockWidget);
+	if (!ContentsLayout || ContentsLayout->isEmpty())
+	{
+		return;
+	}
+
+	// The title bar has been deferred - now we add the tabs of all dock
+	// widgets that have been inserted in the meantime
+	tabBar()->blockSignals(true);
+	for (int i = 0; i < ContentsLayout->count(); ++i)
+	{
+		auto DockWidget = dockWidgetAt(i);
+		auto TabWidget = DockWidget->tabWidget();
+		tabBar()->insertTab(i, TabWidget);
+		TabWidget->setVisible(!DockWidget->isClosed());
+	}
+	tabBar()->blockSignals(false);
+	tabBar()->setCurrentIndex(ContentsLayout->currentIndex());
+
+	// The single dock area of a floating widget has no undock and close
+	// button - see DockContainerWidgetPrivate::onVisibleDockAreaCountChanged()
+	auto Container = _this->dockContainer();
+	if (Container && Container->isFloating() && Container->topLevelDockArea() == _this)
+	{
+		TitleBar->button(TitleBarButtonUndock)->setVisible(false);
+		TitleBar->button(TitleBarButtonClose)->setVisible(false);
+	}
+	updateTitleBarButtonStates();
+	_this->updateGroupMenu();
+	_this->updateTitleBarVisibility();
+}
+
+
+//============================================================================
+bool DockAreaWidgetPrivate::canDeferTitleBar() const
+{
+	if (!CDockManager::testPerformanceFlag(CDockManager::LightweightFloatingWidgets)
+	 || CDockManager::testConfigFlag(CDockManager::AlwaysShowTabs)
+	 || CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+	{
+		return false;
+	}
+
+	auto Container = _this->dockContainer();
+	return Container && Container->isFloating();
 }
 
 
 //============================================================================
 void DockAreaWidgetPrivate::updateTitleBarButtonStates()
 {
+	if (!TitleBar)
+	{
+		return;
+	}
+
 	if (_this->isHidden())
 	{
 		UpdateTitleBarButtons = true;
@@ -377,29 +483,67 @@ CDockAreaWidget::CDockAreaWidget(CDockManager* DockManager, CDockContainerWidget
 	d(new DockAreaWidgetPrivate(this))
 {
 	d->DockManager = DockManager;
+	d->DockContainer = parent;
 	d->Layout = new QBoxLayout(QBoxLayout::TopToBottom);
 	d->Layout->setContentsMargins(0, 0, 0, 0);
 	d->Layout->setSpacing(0);
 	setLayout(d->Layout);
+	CDockStyle::applyTo(this);
 
-	d->createTitleBar();
+	if (!d->canDeferTitleBar())
+	{
+		d->createTitleBar();
+	}
 	d->ContentsLayout = new DockAreaLayout(d->Layout);
 	if (d->DockManager)
 	{
 		emit d->DockManager->dockAreaCreated(this);
-        connect(d->DockManager, &CDockManager::dockWidgetAdded, this, [=](CDockWidget*){
-            updateGroupMenu();
-        });
-        connect(d->DockManager, &CDockManager::dockWidgetRemoved, this, [=](CDockWidget*){
-            updateGroupMenu();
-        });
-        connect(d->DockManager, &CDockManager::dockWidgetRenamed, this, [=](CDockWidget*){
-            updateGroupMenu();
-        });
         updateGroupMenu();
 	}
 }
 
+//============================================================================
+CDockAreaWidget* CDockAreaWidget::createDockArea(CDockManager* DockManager,
+	CDockContainerWidget* parent)
+{
+	auto DockArea = DockManager ? DockManager->takePooledDockArea(parent) : nullptr;
+	if (!DockArea)
+	{
+		return new CDockAreaWidget(DockManager, parent);
+	}
+
+	return DockArea;
+}
+
+
+//============================================================================
+void CDockAreaWidget::resetForReuse()
+{
+	d->DockContainer = nullptr;
+	d->RestoredCurrentDockWidget = nullptr;
+	d->AllowedAreas = DefaultAllowedAreas;
+	d->Flags = DefaultFlags;
+	d->MinSizeHint = QSize();
+	d->UpdateTitleBarButtons = false;
+	if (d->ContentSnapshot)
+	{
+		d->ContentSnapshot->hide();
+	}
+
+	if (d->TitleBar)
+	{
+		// The buttons respect the configured visibility, so showing them
+		// restores the state of a new title bar
+		d->TitleBar->button(TitleBarButtonUndock)->setVisible(true);
+		d->TitleBar->button(TitleBarButtonClose)->setVisible(true);
+		d->TitleBar->setVisible(true);
+		d->updateTitleBarButtonStates();
+		d->TitleBar->markTabsMenuOutdated();
+		updateGroupMenu();
+	}
+}
+
+
 //============================================================================
 CDockAreaWidget::~CDockAreaWidget()
 {
@@ -419,10 +563,39 @@ CDockManager* CDockAreaWidget::dockManager() const
 //============================================================================
 CDockContainerWidget* CDockAreaWidget::dockContainer() const
 {
+	// The back pointer is maintained by the container that owns this area.
+	// It is only missing while the area is moved into another container
+	if (d->DockContainer)
+	{
+		Q_ASSERT(!internal::findParent<CDockContainerWidget*>(this)
+			|| internal::findParent<CDockContainerWidget*>(this) == d->DockContainer);
+		return d->DockContainer;
+	}
 	return internal::findParent<CDockContainerWidget*>(this);
 }
 
 
+//============================================================================
+void CDockAreaWidget::setDockContainer(CDockContainerWidget* Container)
+{
+	d->DockContainer = Container;
+}
+
+
+//============================================================================
+void CDockAreaWidget::setRestoredCurrentDockWidget(CDockWidget* DockWidget)
+{
+	d->RestoredCurrentDockWidget = DockWidget;
+}
+
+
+//============================================================================
+CDockWidget* CDockAreaWidget::restoredCurrentDockWidget() const
+{
+	return d->RestoredCurrentDockWidget.data();
+}
+
+
 //============================================================================
 void CDockAreaWidget::addDockWidget(CDockWidget* DockWidget)
 {
@@ -431,32 +604,91 @@ void CDockAreaWidget::addDockWidget(CDockWidget* DockWidget)
 }
 
 
+//============================================================================
+void CDockAreaWidget::addDockWidgets(const QList<CDockWidget*>& DockWidgets)
+{
+	insertDockWidgets(d->ContentsLayout->count(), DockWidgets);
+    updateGroupMenu();
+}
+
+
 //============================================================================
 void CDockAreaWidget::insertDockWidget(int index, CDockWidget* DockWidget,
 	bool Activate)
 {
-	d->ContentsLayout->insertWidget(index, DockWidget);
-	DockWidget->setDockArea(this);
-	DockWidget->tabWidget()->setDockAreaWidget(this);
-	auto TabWidget = DockWidget->tabWidget();
+	insertDockWidgets(index, {DockWidget}, Activate);
+}
+
+
+//============================================================================
+void CDockAreaWidget::insertDockWidgets(int index, const QList<CDockWidget*>& DockWidgets,
+	bool Activate)
+{
+	if (DockWidgets.isEmpty())
+	{
+		return;
+	}
+
+	if (index < 0 || index > d->ContentsLayout->count())
+	{
+		index = d->ContentsLayout->count();
+	}
+
+	// A floating widget with a single dock widget does not need a title bar.
+	// It is created when the second dock widget is inserted
+	if (!d->TitleBar && (d->ContentsLayout->count() + DockWidgets.count() > 1
+	 || !d->canDeferTitleBar()))
+	{
+		d->createTitleBar();
+	}
+
 	// Inserting the tab will change the current index which in turn will
 	// make the tab widget visible in the slot
-	d->tabBar()->blockSignals(true);
-	d->tabBar()->insertTab(index, TabWidget);
-	d->tabBar()->blockSignals(false);
-	TabWidget->setVisible(!DockWidget->isClosed());
-	DockWidget->setProperty(INDEX_PROPERTY, index);
-	d->MinSizeHint.setHeight(qMax(d->MinSizeHint.height(), DockWidget->minimumSizeHint().height()));
-	d->MinSizeHint.setWidth(qMax(d->MinSizeHint.width(), DockWidget->minimumSizeHint().width()));
+	auto TabBar = d->TitleBar ? d->tabBar() : nullptr;
+	if (TabBar)
+	{
+		TabBar->blockSignals(true);
+	}
+	int TabIndex = index;
+	for (auto DockWidget : DockWidgets)
+	{
+		d->ContentsLayout->insertWidget(TabIndex, DockWidget);
+		DockWidget->setDockArea(this);
+		auto TabWidget = DockWidget->tabWidget();
+		TabWidget->setDockAreaWidget(this);
+		if (TabBar)
+		{
+			TabBar->insertTab(TabIndex, TabWidget);
+			TabWidget->setVisible(!DockWidget->isClosed());
+		}
+		else
+		{
+			TabWidget->hide();
+			TabWidget->setParent(DockWidget);
+		}
+		d->MinSizeHint.setHeight(qMax(d->MinSizeHint.height(), DockWidget->minimumSizeHint().height()));
+		d->MinSizeHint.setWidth(qMax(d->MinSizeHint.width(), DockWidget->minimumSizeHint().width()));
+		++TabIndex;
+	}
+	if (TabBar)
+	{
+		TabBar->blockSignals(false);
+	}
+
+	// Like consecutive insertDockWidget() calls, the last inserted dock widget
+	// becomes the current one
 	if (Activate)
 	{
-		setCurrentIndex(index);
+		setCurrentIndex(index + DockWidgets.count() - 1);
 	}
 	// If this dock area is hidden, then we need to make it visible again
 	// by calling DockWidget->toggleViewInternal(true);
+	// The first dock widget that is inserted into a non empty area is the
+	// one that made the area visible
+	int CountBefore = d->ContentsLayout->count() - DockWidgets.count();
 	if (!this->isVisible() && d->ContentsLayout->count() > 1 && !dockManager()->isRestoringState())
 	{
-		DockWidget->toggleViewInternal(true);
+		DockWidgets.at(CountBefore > 0 ? 0 : 1)->toggleViewInternal(true);
 	}
 	d->updateTitleBarButtonStates();
     updateTitleBarVisibility();
@@ -471,9 +703,16 @@ void CDockAreaWidget::removeDockWidget(CDockWidget* DockWidget)
   	auto NextOpenDockWidget = (DockWidget == CurrentDockWidget) ? nextOpenDockWidget(DockWidget) : nullptr;
 
 	d->ContentsLayout->removeWidget(DockWidget);
+	if (d->DockManager)
+	{
+		d->DockManager->removeContentSnapshot(DockWidget);
+	}
 	auto TabWidget = DockWidget->tabWidget();
 	TabWidget->hide();
-	d->tabBar()->removeTab(TabWidget);
+	if (d->TitleBar)
+	{
+		d->tabBar()->removeTab(TabWidget);
+	}
 	TabWidget->setParent(DockWidget);
 	DockWidget->setDockArea(nullptr);
 	CDockContainerWidget* DockContainer = dockContainer();
@@ -485,13 +724,27 @@ void CDockAreaWidget::removeDockWidget(CDockWidget* DockWidget)
 	{
         RE_LOG_DEBUG("Dock Area empty");
 		DockContainer->removeDockArea(this);
-		this->deleteLater();
+		if (d->DockManager)
+		{
+			d->DockManager->releaseDockArea(this);
+		}
+		else
+		{
+			this->deleteLater();
+		}
 		if(DockContainer->dockAreaCount() == 0)
 		{
 			if(CFloatingDockContainer*  FloatingDockContainer = DockContainer->floatingWidget())
 			{
 				FloatingDockContainer->hide();
-				FloatingDockContainer->deleteLater();
+				if (d->DockManager)
+				{
+					d->DockManager->releaseFloatingWidget(FloatingDockContainer);
+				}
+				else
+				{
+					FloatingDockContainer->deleteLater();
+				}
 			}
 		}
 	}
@@ -506,10 +759,13 @@ void CDockAreaWidget::removeDockWidget(CDockWidget* DockWidget)
 	d->updateTitleBarButtonStates();
 	updateTitleBarVisibility();
 	d->updateMinimumSizeHint();
-	auto TopLevelDockWidget = DockContainer->topLevelDockWidget();
-	if (TopLevelDockWidget)
+	if (!d->DockManager || !d->DockManager->deferTopLevelUpdate(DockContainer))
 	{
-		TopLevelDockWidget->emitTopLevelChanged(true);
+		auto TopLevelDockWidget = DockContainer->topLevelDockWidget();
+		if (TopLevelDockWidget)
+		{
+			TopLevelDockWidget->emitTopLevelChanged(true);
+		}
 	}
 
 #if (ADS_DEBUG_LEVEL > 0)
@@ -525,7 +781,7 @@ void CDockAreaWidget::hideAreaWithNoVisibleContent()
 	this->toggleView(false);
 
 	// Hide empty parent splitters
-	auto Splitter = internal::findParent<CDockSplitter*>(this);
+	auto Splitter = internal::parentSplitter<CDockSplitter*>(this);
 	internal::hideEmptyParentSplitters(Splitter);
 
 	//Hide empty floating widget
@@ -607,11 +863,53 @@ void CDockAreaWidget::internalSetCurrentDockWidget(CDockWidget* DockWidget)
 }
 
 
+//============================================================================
+void DockAreaWidgetPrivate::captureContentSnapshot(QWidget* Widget)
+{
+	if (!DockManager || !Widget || !Widget->isVisible())
+	{
+		return;
+	}
+
+	DockManager->cacheContentSnapshot(Widget, Widget->grab());
+}
+
+
+//============================================================================
+void DockAreaWidgetPrivate::showContentSnapshot(QWidget* Widget, const QRect& Rect)
+{
+	if (!DockManager || !_this->isVisible())
+	{
+		return;
+	}
+
+	QPixmap Snapshot = DockManager->contentSnapshot(Widget);
+	if (Snapshot.isNull() || Snapshot.size() / Snapshot.devicePixelRatio() != Rect.size())
+	{
+		return;
+	}
+
+	if (!ContentSnapshot)
+	{
+		ContentSnapshot = new QLabel(_this);
+		ContentSnapshot->setObjectName("dockAreaContentSnapshot");
+		ContentSnapshot->setAttribute(Qt::WA_TransparentForMouseEvents);
+		// The opaque snapshot hides the content below it, so the first
+		// paint of the content is skipped
+		ContentSnapshot->setAttribute(Qt::WA_OpaquePaintEvent);
+	}
+	ContentSnapshot->setPixmap(Snapshot);
+	ContentSnapshot->setGeometry(Rect);
+	ContentSnapshot->raise();
+	ContentSnapshot->show();
+	QTimer::singleShot(0, ContentSnapshot, &QLabel::hide);
+}
+
+
 //============================================================================
 void CDockAreaWidget::setCurrentIndex(int index)
 {
-	auto TabBar = d->tabBar();
-	if (index < 0 || index > (TabBar->count() - 1))
+	if (index < 0 || index > (d->ContentsLayout->count() - 1))
 	{
         RE_LOG_ERROR("Invalid index: %i", index);
 		return;
@@ -624,9 +922,24 @@ void CDockAreaWidget::setCurrentIndex(int index)
 		return;
 	}
 
+	bool ShowSnapshot = d->Flags.testFlag(ContentSnapshots) && cw && cw != nw
+		&& cw->isVisible();
+	QRect ContentRect = ShowSnapshot ? cw->geometry() : QRect();
+	if (ShowSnapshot)
+	{
+		d->captureContentSnapshot(cw);
+	}
+
     emit currentChanging(index);
-    TabBar->setCurrentIndex(index);
+	if (d->TitleBar)
+	{
+		d->tabBar()->setCurrentIndex(index);
+	}
 	d->ContentsLayout->setCurrentIndex(index);
+	if (ShowSnapshot)
+	{
+		d->showContentSnapshot(nw, ContentRect);
+	}
 	d->ContentsLayout->currentWidget()->show();
 	emit currentChanged(index);
 }
@@ -642,7 +955,7 @@ int CDockAreaWidget::currentIndex() const
 //============================================================================
 QRect CDockAreaWidget::titleBarGeometry() const
 {
-	return d->TitleBar->geometry();
+	return d->TitleBar ? d->TitleBar->geometry() : QRect();
 }
 
 //============================================================================
@@ -752,9 +1065,12 @@ void CDockAreaWidget::reorderDockWidget(int fromIndex, int toIndex)
 void CDockAreaWidget::updateGroupMenu()
 {
     if (d->DockManager && d->TitleBar) {
-        CDockGroupMenu *gm = d->DockManager->groupMenu();
-        auto groupMenu = gm->getMenu(this);
-        d->TitleBar->setGroupMenu(groupMenu);
+        if (d->DockManager->deferGroupMenuUpdate()) {
+            return;
+        }
+        // The group menu is maintained incrementally, the title bar only
+        // needs the shared menu once
+        d->TitleBar->setGroupMenu(d->DockManager->groupMenu()->menu());
     }
 }
 
@@ -783,6 +1099,13 @@ void CDockAreaWidget::updateTitleBarVisibility()
         return;
     }
 
+	// A deferred title bar is created as soon as the dock area is no longer
+	// the only dock area of a floating widget
+	if (!d->TitleBar && (Container->dockAreaCount() > 1 || !d->canDeferTitleBar()))
+	{
+		d->createTitleBar();
+	}
+
 	if (d->TitleBar)
 	{
 		bool Hidden = Container->hasTopLevelDockWidget() && (Container->isFloating()
@@ -803,6 +1126,13 @@ void CDockAreaWidget::markTitleBarMenuOutdated()
 }
 
 
+//============================================================================
+void CDockAreaWidget::updateMinimumSizeHint()
+{
+	d->updateMinimumSizeHint();
+}
+
+
 
 //============================================================================
 void CDockAreaWidget::saveState(QXmlStreamWriter& s) const
@@ -934,6 +1264,11 @@ void CDockAreaWidget::setDockAreaFlags(DockAreaFlags Flags)
 	{
 		updateTitleBarVisibility();
 	}
+	if (ChangedFlags.testFlag(ContentSnapshots) && !Flags.testFlag(ContentSnapshots)
+	 && d->ContentSnapshot)
+	{
+		d->ContentSnapshot->hide();
+	}
 }
 
 
@@ -949,7 +1284,7 @@ void CDockAreaWidget::setDockAreaFlag(eDockAreaFlag Flag, bool On)
 //============================================================================
 QAbstractButton* CDockAreaWidget::titleBarButton(TitleBarButton which) const
 {
-	return d->TitleBar->button(which);
+	return titleBar()->button(which);
 }
 
 
@@ -983,10 +1318,21 @@ void CDockAreaWidget::closeOtherAreas()
 //============================================================================
 CDockAreaTitleBar* CDockAreaWidget::titleBar() const
 {
+	if (!d->TitleBar)
+	{
+		d->createTitleBar();
+	}
 	return d->TitleBar;
 }
 
 
+//============================================================================
+bool CDockAreaWidget::hasTitleBar() const
+{
+	return d->TitleBar != nullptr;
+}
+
+
 //============================================================================
 bool CDockAreaWidget::isCentralWidgetArea() const
 {
@@ -82,6 +82,20 @@ private slots:
     void updateGroupMenu();
 
 protected:
+	/**
+	 * Sets the back pointer to the container that owns this area.
+	 * The container calls this function if it adds or removes the area
+	 */
+	void setDockContainer(CDockContainerWidget* Container);
+
+	/**
+	 * The state restore stores the current dock widget of the saved state
+	 * here. The dock manager activates it after all dock widgets have been
+	 * restored
+	 */
+	void setRestoredCurrentDockWidget(CDockWidget* DockWidget);
+	CDockWidget* restoredCurrentDockWidget() const;
+
 	/**
 	 * Inserts a dock widget into dock area.
 	 * All dockwidgets in the dock area tabified in a stacked layout with tabs.
@@ -91,12 +105,26 @@ protected:
 	 */
 	void insertDockWidget(int index, CDockWidget* DockWidget, bool Activate = true);
 
+	/**
+	 * Inserts the given dock widgets starting at the given index.
+	 * The title bar, the group menu and the current index are updated only
+	 * once for all dock widgets. If the Activate parameter is true, the
+	 * last inserted dock widget will be the active one
+	 */
+	void insertDockWidgets(int index, const QList<CDockWidget*>& DockWidgets,
+		bool Activate = true);
+
 	/**
 	 * Add a new dock widget to dock area.
 	 * All dockwidgets in the dock area tabified in a stacked layout with tabs
 	 */
 	void addDockWidget(CDockWidget* DockWidget);
 
+	/**
+	 * Appends the given dock widgets as tabs to this dock area
+	 */
+	void addDockWidgets(const QList<CDockWidget*>& DockWidgets);
+
 	/**
 	 * Removes the given dock widget from the dock area
 	 */
@@ -143,6 +171,21 @@ protected:
 	 */
 	void markTitleBarMenuOutdated();
 
+	/**
+	 * Recomputes the minimum size hint from the minimum size hints of all
+	 * dock widgets. The geometry is only updated if the hint has changed.
+	 * This function is called by a dock widget if its minimum size hint
+	 * has changed
+	 */
+	void updateMinimumSizeHint();
+
+	/**
+	 * Clears this empty dock area, so that the dock manager can put it into
+	 * its dock area pool. Flags, allowed areas, title bar buttons and the
+	 * group menu are reset to the state of a new dock area
+	 */
+	void resetForReuse();
+
 protected slots:
 	void toggleView(bool Open);
 
@@ -155,6 +198,7 @@ public:
 	enum eDockAreaFlag
 	{
 		HideSingleWidgetTitleBar = 0x0001,
+		ContentSnapshots = 0x0002, ///< shows a cached snapshot of the content on a tab switch until the real content has been painted
 		DefaultFlags = 0x0000
 	};
 	Q_DECLARE_FLAGS(DockAreaFlags, eDockAreaFlag)
@@ -169,6 +213,15 @@ public:
 	 */
 	virtual ~CDockAreaWidget();
 
+	/**
+	 * Returns a new dock area for the given container.
+	 * The dock area is taken from the dock area pool of the dock manager if
+	 * the pool is enabled and not empty.
+	 * See CDockManager::setDockAreaPoolSize()
+	 */
+	static CDockAreaWidget* createDockArea(CDockManager* DockManager,
+		CDockContainerWidget* parent);
+
 	/**
 	 * Returns the dock manager object this dock area belongs to
 	 */
@@ -289,10 +342,19 @@ public:
 	DockWidgetAreas allowedAreas() const;
 
 	/**
-	 * Returns the title bar of this dock area
+	 * Returns the title bar of this dock area.
+	 * If the creation of the title bar has been deferred, the title bar is
+	 * created now.
+	 * \see CDockManager::LightweightFloatingWidgets
 	 */
 	CDockAreaTitleBar* titleBar() const;
 
+	/**
+	 * Returns true, if the title bar of this dock area has been created.
+	 * Use this function to avoid the creation of a deferred title bar.
+	 */
+	bool hasTitleBar() const;
+
 	/**
 	 * Returns the dock area flags - a combination of flags that configure the
 	 * appearance and features of the dock area.
@@ -33,6 +33,7 @@
 #include <QEvent>
 #include <QList>
 #include <QGridLayout>
+#include <QHash>
 #include <QPointer>
 #include <QVariant>
 #include <QDebug>
@@ -47,6 +48,9 @@
 #include "DockOverlay.h"
 #include "ads_globals.h"
 #include "DockSplitter.h"
+#include "DockLayout.h"
+#include "DockFlatLayout.h"
+#include "DockStyle.h"
 
 #include <functional>
 #include <iostream>
@@ -127,6 +131,55 @@ static void insertWidgetIntoSplitter(QSplitter* Splitter, QWidget* widget, bool
 	}
 }
 
+/**
+ * Reads the orientation and the widget count of a splitter element
+ */
+static bool readSplitterAttributes(CDockingStateReader& s,
+	Qt::Orientation& Orientation, int& WidgetCount)
+{
+	QString OrientationStr = s.attributes().value("Orientation").toString();
+
+	// Check if the orientation string is right
+	if (!OrientationStr.startsWith("|") && !OrientationStr.startsWith("-"))
+	{
+		return false;
+	}
+
+	// The "|" shall indicate a vertical splitter handle which in turn means
+	// a Horizontal orientation of the splitter layout.
+	bool HorizontalSplitter = OrientationStr.startsWith("|");
+	// In version 0 we had a small bug. The "|" indicated a vertical orientation,
+	// but this is wrong, because only the splitter handle is vertical, the
+	// layout of the splitter is a horizontal layout. We fix this here
+	if (s.fileVersion() == 0)
+	{
+		HorizontalSplitter = !HorizontalSplitter;
+	}
+
+	Orientation = HorizontalSplitter ? Qt::Horizontal : Qt::Vertical;
+	bool Ok;
+	WidgetCount = s.attributes().value("Count").toInt(&Ok);
+	return Ok;
+}
+
+/**
+ * Reads the sizes of a splitter element
+ */
+static QList<int> readSplitterSizes(CDockingStateReader& s)
+{
+	QList<int> Sizes;
+	QString sSizes = s.readElementText().trimmed();
+    ADS_PRINT("Sizes: " << sSizes);
+	QTextStream TextStream(&sSizes);
+	while (!TextStream.atEnd())
+	{
+		int value;
+		TextStream >> value;
+		Sizes.append(value);
+	}
+	return Sizes;
+}
+
 /**
  * Private data class of CDockContainerWidget class (pimpl)
  */
@@ -139,9 +192,13 @@ public:
 	QList<CDockAreaWidget*> DockAreas;
 	QGridLayout* Layout = nullptr;
 	QSplitter* RootSplitter = nullptr;
+	CDockFlatLayoutWidget* FlatLayoutWidget = nullptr;
+	CFloatingDockContainer* FloatingWidget = nullptr;
 	bool isFloating = false;
 	CDockAreaWidget* LastAddedAreaCache[5];
 	int VisibleDockAreaCount = -1;
+	int BulkInsertionDepth = 0;
+	QHash<QSplitter*, QPointer<QSplitter>> PendingEqualSplits;
 
 	/**
 	 * Private data constructor
@@ -227,6 +284,36 @@ public:
 	bool restoreChildNodes(CDockingStateReader& Stream, QWidget*& CreatedWidget,
 		bool Testing);
 
+	/**
+	 * Creates the splitter or dock area for the given layout node and all
+	 * of its children.
+	 * Returns a nullptr if the node does not contain any dock widget
+	 */
+	QWidget* buildLayoutNode(const CDockLayoutNode& Node);
+
+	/**
+	 * Creates the flat layout node for the given layout node and all of its
+	 * children.
+	 * Returns false if the node does not contain any dock widget
+	 */
+	bool buildFlatLayoutNode(const CDockLayoutNode& Node, CDockFlatLayoutNode& FlatNode);
+
+	/**
+	 * Save state of the given node of the flat layout
+	 */
+	void saveFlatNodeState(QXmlStreamWriter& Stream, const CDockFlatLayoutNode& Node);
+
+	/**
+	 * Restores the split tree of the flat layout.
+	 * The stream data is the same as for restoreChildNodes()
+	 */
+	bool restoreFlatChildNodes(CDockingStateReader& Stream, CDockFlatLayoutNode& Root);
+
+	/**
+	 * Restores a splitter as split node of the flat layout
+	 */
+	bool restoreFlatSplitter(CDockingStateReader& Stream, CDockFlatLayoutNode& Node);
+
 	/**
 	 * Restores a splitter.
 	 * \see restoreChildNodes() for details
@@ -246,6 +333,11 @@ public:
 	 */
 	void dumpRecursive(int level, QWidget* widget);
 
+	/**
+	 * Helper function for recursive dumping of the flat layout
+	 */
+	void dumpFlatRecursive(int level, const CDockFlatLayoutNode& Node);
+
 	/**
 	 * Calculate the drop mode from the given target position
 	 */
@@ -307,6 +399,7 @@ public:
 	{
 		CDockSplitter* s = new CDockSplitter(orientation, parent);
 		s->setOpaqueResize(CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize));
+		s->setOpaqueResizeInterval(CDockManager::splitterResizeInterval());
 		s->setChildrenCollapsible(false);
         QObject::connect(s, &CDockSplitter::splitterMoved, _this, [=](int, int){
             emit _this->splitterMoved();
@@ -314,12 +407,42 @@ public:
 		return s;
 	}
 
+	/**
+	 * Helper function for creation of the host widget of the flat layout
+	 */
+	CDockFlatLayoutWidget* newFlatLayoutWidget()
+	{
+		auto w = new CDockFlatLayoutWidget();
+		w->setOpaqueResize(CDockManager::testConfigFlag(CDockManager::OpaqueSplitterResize));
+		w->setOpaqueResizeInterval(CDockManager::splitterResizeInterval());
+		QObject::connect(w, &CDockFlatLayoutWidget::handleMoved, _this, [=]() {
+			emit _this->splitterMoved();
+		});
+		return w;
+	}
+
+	/**
+	 * Returns the flat layout or a nullptr if the container uses splitters
+	 */
+	CDockFlatLayout* flatLayout() const
+	{
+		return FlatLayoutWidget ? FlatLayoutWidget->flatLayout() : nullptr;
+	}
+
 	/**
 	 * Ensures equal distribution of the sizes of a splitter if an dock widget
 	 * is inserted from code
 	 */
 	void adjustSplitterSizesOnInsertion(QSplitter* Splitter, qreal LastRatio = 1.0)
 	{
+		// In bulk insertion mode, the sizes are distributed once when the
+		// insertion ends
+		if (BulkInsertionDepth && 1.0 == LastRatio)
+		{
+			PendingEqualSplits.insert(Splitter, Splitter);
+			return;
+		}
+
 		int AreaSize = (Splitter->orientation() == Qt::Horizontal) ? Splitter->width() : Splitter->height();
 		auto SplitterSizes = Splitter->sizes();
 
@@ -410,7 +533,8 @@ void DockContainerWidgetPrivate::onVisibleDockAreaCountChanged()
 {
 	auto TopLevelDockArea = _this->topLevelDockArea();
 
-	if (TopLevelDockArea)
+	// A deferred title bar hides the buttons when it is created
+	if (TopLevelDockArea && TopLevelDockArea->hasTitleBar())
 	{
 		TopLevelDockArea->titleBarButton(TitleBarButtonUndock)->setVisible(false || !_this->isFloating());
 		TopLevelDockArea->titleBarButton(TitleBarButtonClose)->setVisible(false || !_this->isFloating());
@@ -426,6 +550,15 @@ void DockContainerWidgetPrivate::dropIntoContainer(CFloatingDockContainer* Float
 	CDockContainerWidget* FloatingDockContainer = FloatingWidget->dockContainer();
 	auto NewDockAreas = FloatingDockContainer->findChildren<CDockAreaWidget*>(
 		QString(), Qt::FindChildrenRecursively);
+	if (FlatLayoutWidget)
+	{
+		auto Tree = FloatingDockContainer->flatLayoutWidget()->flatLayout()->takeRoot();
+		flatLayout()->insertTree(Tree, area);
+		addDockAreasToList(NewDockAreas);
+		_this->dumpLayout();
+		return;
+	}
+
 	QSplitter* Splitter = RootSplitter;
 
 	if (DockAreas.count() <= 1)
@@ -527,7 +660,16 @@ void DockContainerWidgetPrivate::dropIntoSection(CFloatingDockContainer* Floatin
 	auto InsertParam = internal::dockAreaInsertParameters(area);
 	auto NewDockAreas = FloatingWidget->dockContainer()->findChildren<CDockAreaWidget*>(
 		QString(), Qt::FindChildrenRecursively);
-	QSplitter* TargetAreaSplitter = internal::findParent<QSplitter*>(TargetArea);
+	if (FlatLayoutWidget)
+	{
+		auto Tree = FloatingWidget->dockContainer()->flatLayoutWidget()->flatLayout()->takeRoot();
+		flatLayout()->insertTree(Tree, area, TargetArea);
+		addDockAreasToList(NewDockAreas);
+		_this->dumpLayout();
+		return;
+	}
+
+	QSplitter* TargetAreaSplitter = internal::parentSplitter<QSplitter*>(TargetArea);
 
 	if (!TargetAreaSplitter)
 	{
@@ -642,7 +784,7 @@ void DockContainerWidgetPrivate::moveIntoCenterOfSection(QWidget* Widget, CDockA
 		}
 		TargetArea->setCurrentIndex(NewCurrentIndex);
 		DroppedArea->dockContainer()->removeDockArea(DroppedArea);
-		DroppedArea->deleteLater();
+		DockManager->releaseDockArea(DroppedArea);
 	}
 
 	TargetArea->updateTitleBarVisibility();
@@ -667,7 +809,7 @@ void DockContainerWidgetPrivate::moveToNewSection(QWidget* Widget, CDockAreaWidg
 	CDockAreaWidget* NewDockArea;
 	if (DroppedDockWidget)
 	{
-		NewDockArea = new CDockAreaWidget(DockManager, _this);
+		NewDockArea = CDockAreaWidget::createDockArea(DockManager, _this);
 		CDockAreaWidget* OldDockArea = DroppedDockWidget->dockAreaWidget();
 		if (OldDockArea)
 		{
@@ -681,8 +823,15 @@ void DockContainerWidgetPrivate::moveToNewSection(QWidget* Widget, CDockAreaWidg
 		NewDockArea = DroppedDockArea;
 	}
 
+	if (FlatLayoutWidget)
+	{
+		flatLayout()->insertWidget(NewDockArea, area, TargetArea);
+		addDockAreasToList({NewDockArea});
+		return;
+	}
+
 	auto InsertParam = internal::dockAreaInsertParameters(area);
-	QSplitter* TargetAreaSplitter = internal::findParent<QSplitter*>(TargetArea);
+	QSplitter* TargetAreaSplitter = internal::parentSplitter<QSplitter*>(TargetArea);
 	int AreaIndex = TargetAreaSplitter->indexOf(TargetArea);
 	auto Sizes = TargetAreaSplitter->sizes();
 	if (TargetAreaSplitter->orientation() == InsertParam.orientation())
@@ -716,11 +865,23 @@ void DockContainerWidgetPrivate::moveToNewSection(QWidget* Widget, CDockAreaWidg
 //============================================================================
 void DockContainerWidgetPrivate::updateSplitterHandles( QSplitter* splitter )
 {
+	// The flat layout looks up the central widget area in its next pass
+	if (FlatLayoutWidget)
+	{
+		FlatLayoutWidget->flatLayout()->invalidate();
+		return;
+	}
+
 	if (!DockManager->centralWidget() || !splitter)
 	{
 		return;
 	}
 
+	if (DockManager->deferSplitterHandleUpdate(splitter))
+	{
+		return;
+	}
+
 	for (int i = 0; i < splitter->count(); ++i)
     {
 		splitter->setStretchFactor(i, widgetResizesWithContainer(splitter->widget(i)) ? 1 : 0);
@@ -745,7 +906,10 @@ bool DockContainerWidgetPrivate::widgetResizesWithContainer(QWidget* widget)
     auto innerSplitter = qobject_cast<CDockSplitter*>(widget);
     if (innerSplitter)
     {
-        return innerSplitter->isResizingWithContainer();
+        // The splitter resizes with the container if it contains the area
+        // of the central widget
+        auto CentralArea = DockManager->centralWidget()->dockAreaWidget();
+        return CentralArea && innerSplitter->isAncestorOf(CentralArea);
     }
 
     return false;
@@ -762,7 +926,7 @@ void DockContainerWidgetPrivate::moveToContainer(QWidget* Widget, DockWidgetArea
 
 	if (DroppedDockWidget)
 	{
-		NewDockArea = new CDockAreaWidget(DockManager, _this);
+		NewDockArea = CDockAreaWidget::createDockArea(DockManager, _this);
 		CDockAreaWidget* OldDockArea = DroppedDockWidget->dockAreaWidget();
 		if (OldDockArea)
 		{
@@ -776,9 +940,9 @@ void DockContainerWidgetPrivate::moveToContainer(QWidget* Widget, DockWidgetArea
 		// it already has and do nothing, if it is the same place. It would
 		// also work without this check, but it looks nicer with the check
 		// because there will be no layout updates
-		auto Splitter = internal::findParent<CDockSplitter*>(DroppedDockArea);
+		auto Splitter = internal::parentSplitter<CDockSplitter*>(DroppedDockArea);
 		auto InsertParam = internal::dockAreaInsertParameters(area);
-		if (Splitter == RootSplitter && InsertParam.orientation() == Splitter->orientation())
+		if (Splitter && Splitter == RootSplitter && InsertParam.orientation() == Splitter->orientation())
 		{
 			if (InsertParam.append() && Splitter->lastWidget() == DroppedDockArea)
 			{
@@ -835,6 +999,7 @@ void DockContainerWidgetPrivate::appendDockAreas(const QList<CDockAreaWidget*> N
 	DockAreas.append(NewDockAreas);
 	for (auto DockArea : NewDockAreas)
 	{
+		DockArea->setDockContainer(_this);
 		QObject::connect(DockArea,
 			&CDockAreaWidget::viewToggled,
 			_this,
@@ -886,40 +1051,55 @@ void DockContainerWidgetPrivate::saveChildNodesState(QXmlStreamWriter& s, QWidge
 
 
 //============================================================================
-bool DockContainerWidgetPrivate::restoreSplitter(CDockingStateReader& s,
-	QWidget*& CreatedWidget, bool Testing)
+void DockContainerWidgetPrivate::saveFlatNodeState(QXmlStreamWriter& s,
+	const CDockFlatLayoutNode& Node)
 {
-	bool Ok;
-	QString OrientationStr = s.attributes().value("Orientation").toString();
-
-	// Check if the orientation string is right
-	if (!OrientationStr.startsWith("|") && !OrientationStr.startsWith("-"))
+	if (Node.isLeaf())
 	{
-		return false;
+		CDockAreaWidget* DockArea = qobject_cast<CDockAreaWidget*>(Node.Widget);
+		if (DockArea)
+		{
+			DockArea->saveState(s);
+		}
+		return;
 	}
 
-	// The "|" shall indicate a vertical splitter handle which in turn means
-	// a Horizontal orientation of the splitter layout.
-	bool HorizontalSplitter = OrientationStr.startsWith("|");
-	// In version 0 we had a small bug. The "|" indicated a vertical orientation,
-	// but this is wrong, because only the splitter handle is vertical, the
-	// layout of the splitter is a horizontal layout. We fix this here
-	if (s.fileVersion() == 0)
-	{
-		HorizontalSplitter = !HorizontalSplitter;
-	}
+	// Split nodes are saved like splitters, so a saved state can be
+	// restored with both layout engines
+	s.writeStartElement("Splitter");
+	s.writeAttribute("Orientation", (Node.Orientation == Qt::Horizontal) ? "|" : "-");
+	s.writeAttribute("Count", QString::number(Node.Children.count()));
+		for (const auto& Child : Node.Children)
+		{
+			saveFlatNodeState(s, Child);
+		}
 
-	int Orientation = HorizontalSplitter ? Qt::Horizontal : Qt::Vertical;
-	int WidgetCount = s.attributes().value("Count").toInt(&Ok);
-	if (!Ok)
+		s.writeStartElement("Sizes");
+		for (const auto& Child : Node.Children)
+		{
+			// Like QSplitter::sizes(), hidden nodes have the size 0
+			s.writeCharacters(QString::number(Child.hasVisibleContent() ? Child.Size : 0) + " ");
+		}
+		s.writeEndElement();
+	s.writeEndElement();
+}
+
+
+//============================================================================
+bool DockContainerWidgetPrivate::restoreSplitter(CDockingStateReader& s,
+	QWidget*& CreatedWidget, bool Testing)
+{
+	Qt::Orientation Orientation;
+	int WidgetCount;
+	if (!readSplitterAttributes(s, Orientation, WidgetCount))
 	{
 		return false;
 	}
-    RE_LOG_DEBUG("Restore NodeSplitter Orientation: %s WidgetCount: %i", OrientationStr, WidgetCount);
+    RE_LOG_DEBUG("Restore NodeSplitter Orientation: %i WidgetCount: %i", Orientation, WidgetCount);
     QSplitter* Splitter = nullptr;
 	if (!Testing)
 	{
-		Splitter = newSplitter(static_cast<Qt::Orientation>(Orientation));
+		Splitter = newSplitter(Orientation);
 	}
 	bool Visible = false;
 	QList<int> Sizes;
@@ -937,15 +1117,7 @@ bool DockContainerWidgetPrivate::restoreSplitter(CDockingStateReader& s,
 		}
 		else if (s.name() == "Sizes")
 		{
-			QString sSizes = s.readElementText().trimmed();
-            ADS_PRINT("Sizes: " << sSizes);
-			QTextStream TextStream(&sSizes);
-			while (!TextStream.atEnd())
-			{
-				int value;
-				TextStream >> value;
-				Sizes.append(value);
-			}
+			Sizes = readSplitterSizes(s);
 		}
 		else
 		{
@@ -1017,9 +1189,10 @@ bool DockContainerWidgetPrivate::restoreDockArea(CDockingStateReader& s,
     RE_LOG_DEBUG("Restore NodeDockArea Current: %s ", CurrentDockWidget);
 
 	CDockAreaWidget* DockArea = nullptr;
+	CDockWidget* RestoredCurrentDockWidget = nullptr;
 	if (!Testing)
 	{
-		DockArea = new CDockAreaWidget(DockManager, _this);
+		DockArea = CDockAreaWidget::createDockArea(DockManager, _this);
 		const auto AllowedAreasAttribute = s.attributes().value("AllowedAreas");
 		if (!AllowedAreasAttribute.isEmpty())
 		{
@@ -1066,8 +1239,12 @@ bool DockContainerWidgetPrivate::restoreDockArea(CDockingStateReader& s,
 		DockArea->addDockWidget(DockWidget);
 		DockWidget->setToggleViewActionChecked(!Closed);
 		DockWidget->setClosedState(Closed);
-		DockWidget->setProperty(internal::ClosedProperty, Closed);
-		DockWidget->setProperty(internal::DirtyProperty, false);
+		DockWidget->setRestoreClosed(Closed);
+		DockWidget->setRestoreDirty(false);
+		if (ObjectName == CurrentDockWidget)
+		{
+			RestoredCurrentDockWidget = DockWidget;
+		}
 	}
 
 	if (Testing)
@@ -1082,7 +1259,7 @@ bool DockContainerWidgetPrivate::restoreDockArea(CDockingStateReader& s,
 	}
 	else
 	{
-		DockArea->setProperty("currentDockWidget", CurrentDockWidget);
+		DockArea->setRestoredCurrentDockWidget(RestoredCurrentDockWidget);
 		appendDockAreas({DockArea});
 	}
 
@@ -1119,11 +1296,201 @@ bool DockContainerWidgetPrivate::restoreChildNodes(CDockingStateReader& s,
 }
 
 
+//============================================================================
+bool DockContainerWidgetPrivate::restoreFlatChildNodes(CDockingStateReader& s,
+	CDockFlatLayoutNode& Root)
+{
+	bool Result = true;
+	while (s.readNextStartElement())
+	{
+		if (s.name() == "Splitter")
+		{
+			Result = restoreFlatSplitter(s, Root);
+		}
+		else if (s.name() == "Area")
+		{
+			QWidget* DockArea = nullptr;
+			Result = restoreDockArea(s, DockArea, false);
+			if (DockArea)
+			{
+				CDockFlatLayoutNode Leaf;
+				Leaf.Widget = DockArea;
+				Root.Children.append(Leaf);
+			}
+		}
+		else
+		{
+			s.skipCurrentElement();
+		}
+	}
+	return Result;
+}
+
+
+//============================================================================
+bool DockContainerWidgetPrivate::restoreFlatSplitter(CDockingStateReader& s,
+	CDockFlatLayoutNode& Node)
+{
+	int WidgetCount;
+	if (!readSplitterAttributes(s, Node.Orientation, WidgetCount))
+	{
+		return false;
+	}
+
+	QList<int> Sizes;
+	while (s.readNextStartElement())
+	{
+		bool Result = true;
+		CDockFlatLayoutNode ChildNode;
+		if (s.name() == "Splitter")
+		{
+			Result = restoreFlatSplitter(s, ChildNode);
+		}
+		else if (s.name() == "Area")
+		{
+			QWidget* DockArea = nullptr;
+			Result = restoreDockArea(s, DockArea, false);
+			ChildNode.Widget = DockArea;
+		}
+		else if (s.name() == "Sizes")
+		{
+			Sizes = readSplitterSizes(s);
+			continue;
+		}
+		else
+		{
+			s.skipCurrentElement();
+			continue;
+		}
+
+		if (!Result)
+		{
+			return false;
+		}
+
+		// Empty splitters and dock areas are dropped like in restoreSplitter()
+		if (ChildNode.isLeaf() || !ChildNode.Children.isEmpty())
+		{
+			Node.Children.append(ChildNode);
+		}
+	}
+
+	if (Sizes.count() != WidgetCount)
+	{
+		return false;
+	}
+
+	// Like QSplitter::setSizes(), the sizes are assigned in order
+	for (int i = 0; i < Node.Children.count(); ++i)
+	{
+		Node.Children[i].Size = Sizes[i];
+	}
+	return true;
+}
+
+
+//============================================================================
+QWidget* DockContainerWidgetPrivate::buildLayoutNode(const CDockLayoutNode& Node)
+{
+	if (CDockLayoutNode::AreaNode == Node.type())
+	{
+		QList<CDockWidget*> DockWidgets;
+		int CurrentIndex = 0;
+		for (const auto& Name : Node.dockWidgets())
+		{
+			auto DockWidget = DockManager->findDockWidget(Name);
+			if (!DockWidget)
+			{
+				continue;
+			}
+			if (Name == Node.currentDockWidget())
+			{
+				CurrentIndex = DockWidgets.count();
+			}
+			auto OldDockArea = DockWidget->dockAreaWidget();
+			if (OldDockArea)
+			{
+				OldDockArea->removeDockWidget(DockWidget);
+			}
+			DockWidget->setDockManager(DockManager);
+			DockWidgets.append(DockWidget);
+		}
+
+		if (DockWidgets.isEmpty())
+		{
+			return nullptr;
+		}
+
+		auto DockArea = CDockAreaWidget::createDockArea(DockManager, _this);
+		DockArea->insertDockWidgets(0, DockWidgets);
+		if (CurrentIndex)
+		{
+			DockArea->setCurrentIndex(CurrentIndex);
+		}
+		appendDockAreas({DockArea});
+		return DockArea;
+	}
+
+	auto Splitter = newSplitter(Node.orientation());
+	QList<int> Sizes;
+	for (const auto& Child : Node.children())
+	{
+		auto ChildWidget = buildLayoutNode(Child);
+		if (!ChildWidget)
+		{
+			continue;
+		}
+		Splitter->addWidget(ChildWidget);
+		// QSplitter distributes the available space proportionally to the
+		// given sizes
+		Sizes.append(qMax(1, qRound(Child.size() * 1000)));
+	}
+
+	if (!Splitter->count())
+	{
+		delete Splitter;
+		return nullptr;
+	}
+
+	Splitter->setSizes(Sizes);
+	updateSplitterHandles(Splitter);
+	return Splitter;
+}
+
+
+//============================================================================
+bool DockContainerWidgetPrivate::buildFlatLayoutNode(const CDockLayoutNode& Node,
+	CDockFlatLayoutNode& FlatNode)
+{
+	if (CDockLayoutNode::AreaNode == Node.type())
+	{
+		FlatNode.Widget = buildLayoutNode(Node);
+		return FlatNode.Widget != nullptr;
+	}
+
+	FlatNode.Orientation = Node.orientation();
+	for (const auto& Child : Node.children())
+	{
+		CDockFlatLayoutNode ChildNode;
+		if (!buildFlatLayoutNode(Child, ChildNode))
+		{
+			continue;
+		}
+		// The flat layout distributes the available space proportionally
+		// to the given sizes
+		ChildNode.Size = qMax(1, qRound(Child.size() * 1000));
+		FlatNode.Children.append(ChildNode);
+	}
+
+	return !FlatNode.Children.isEmpty();
+}
+
+
 //============================================================================
 CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToContainer(DockWidgetArea area,
 	CDockWidget* Dockwidget)
 {
-	CDockAreaWidget* NewDockArea = new CDockAreaWidget(DockManager, _this);
+	CDockAreaWidget* NewDockArea = CDockAreaWidget::createDockArea(DockManager, _this);
 	NewDockArea->addDockWidget(Dockwidget);
 	addDockArea(NewDockArea, area);
 	NewDockArea->updateTitleBarVisibility();
@@ -1135,6 +1502,13 @@ CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToContainer(DockWidget
 //============================================================================
 void DockContainerWidgetPrivate::addDockArea(CDockAreaWidget* NewDockArea, DockWidgetArea area)
 {
+	if (FlatLayoutWidget)
+	{
+		flatLayout()->insertWidget(NewDockArea, area);
+		addDockAreasToList({NewDockArea});
+		return;
+	}
+
 	auto InsertParam = internal::dockAreaInsertParameters(area);
 	// As long as we have only one dock area in the splitter we can adjust
 	// its orientation
@@ -1235,6 +1609,35 @@ void DockContainerWidgetPrivate::dumpRecursive(int level, QWidget* widget)
 }
 
 
+//============================================================================
+void DockContainerWidgetPrivate::dumpFlatRecursive(int level, const CDockFlatLayoutNode& Node)
+{
+#if defined(QT_DEBUG)
+	if (Node.isLeaf())
+	{
+		dumpRecursive(level, Node.Widget);
+		return;
+	}
+
+#ifdef ADS_DEBUG_PRINT
+	QByteArray buf;
+	buf.fill(' ', level * 4);
+	std::cout << (const char*)buf << "Split "
+		<< ((Node.Orientation == Qt::Vertical) ? "--" : "|") << " "
+		<< (Node.hasVisibleContent() ? "v" : " ") << " "
+		<< Node.Children.count() << std::endl;
+#endif
+	for (const auto& Child : Node.Children)
+	{
+		dumpFlatRecursive(level + 1, Child);
+	}
+#else
+	Q_UNUSED(level);
+	Q_UNUSED(Node);
+#endif
+}
+
+
 //============================================================================
 CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToDockArea(DockWidgetArea area,
 	CDockWidget* Dockwidget, CDockAreaWidget* TargetDockArea)
@@ -1246,11 +1649,25 @@ CDockAreaWidget* DockContainerWidgetPrivate::addDockWidgetToDockArea(DockWidgetA
 		return TargetDockArea;
 	}
 
-	CDockAreaWidget* NewDockArea = new CDockAreaWidget(DockManager, _this);
+	CDockAreaWidget* NewDockArea = CDockAreaWidget::createDockArea(DockManager, _this);
 	NewDockArea->addDockWidget(Dockwidget);
+	if (FlatLayoutWidget)
+	{
+		flatLayout()->insertWidget(NewDockArea, area, TargetDockArea);
+		// The sizes are only data, so there is no need to defer the equal
+		// split during bulk insertion
+		if (CDockManager::testConfigFlag(CDockManager::EqualSplitOnInsertion))
+		{
+			flatLayout()->distributeEvenly(NewDockArea);
+		}
+		appendDockAreas({NewDockArea});
+		emitDockAreasAdded();
+		return NewDockArea;
+	}
+
 	auto InsertParam = internal::dockAreaInsertParameters(area);
 
-	QSplitter* TargetAreaSplitter = internal::findParent<QSplitter*>(TargetDockArea);
+	QSplitter* TargetAreaSplitter = internal::parentSplitter<QSplitter*>(TargetDockArea);
 	int index = TargetAreaSplitter ->indexOf(TargetDockArea);
 	if (TargetAreaSplitter->orientation() == InsertParam.orientation())
 	{
@@ -1294,12 +1711,16 @@ CDockContainerWidget::CDockContainerWidget(CDockManager* DockManager, QWidget *p
 	d(new DockContainerWidgetPrivate(this))
 {
 	d->DockManager = DockManager;
-	d->isFloating = floatingWidget() != nullptr;
+	// A container never changes its floating widget, so the pointer is
+	// looked up only once
+	d->FloatingWidget = internal::findParent<CFloatingDockContainer*>(this);
+	d->isFloating = d->FloatingWidget != nullptr;
 
 	d->Layout = new QGridLayout();
     d->Layout->setContentsMargins(0, 2, 0, 2);
 	d->Layout->setSpacing(0);
 	setLayout(d->Layout);
+	CDockStyle::applyTo(this);
 
 	// The function d->newSplitter() accesses the config flags from dock
 	// manager which in turn requires a properly constructed dock manager.
@@ -1345,6 +1766,33 @@ CDockAreaWidget* CDockContainerWidget::addDockWidget(DockWidgetArea area, CDockW
 	}
 }
 
+//============================================================================
+void CDockContainerWidget::beginBulkInsertion()
+{
+	d->BulkInsertionDepth++;
+}
+
+
+//============================================================================
+void CDockContainerWidget::endBulkInsertion()
+{
+	if (d->BulkInsertionDepth <= 0 || --d->BulkInsertionDepth > 0)
+	{
+		return;
+	}
+
+	auto PendingEqualSplits = std::move(d->PendingEqualSplits);
+	d->PendingEqualSplits.clear();
+	for (auto& Splitter : PendingEqualSplits)
+	{
+		if (Splitter)
+		{
+			d->adjustSplitterSizesOnInsertion(Splitter);
+		}
+	}
+}
+
+
 //============================================================================
 void CDockContainerWidget::removeDockWidget(CDockWidget* Dockwidget)
 {
@@ -1407,7 +1855,11 @@ void CDockContainerWidget::removeDockArea(CDockAreaWidget* area)
     ADS_PRINT("CDockContainerWidget::removeDockArea");
 	area->disconnect(this);
 	d->DockAreas.removeAll(area);
-	CDockSplitter* Splitter = internal::findParent<CDockSplitter*>(area);
+	if (area->dockContainer() == this)
+	{
+		area->setDockContainer(nullptr);
+	}
+	CDockSplitter* Splitter = internal::parentSplitter<CDockSplitter*>(area);
 
 	// Remove are from parent splitter and recursively hide tree of parent
 	// splitters if it has no visible content
@@ -1420,6 +1872,13 @@ void CDockContainerWidget::removeDockArea(CDockAreaWidget* area)
 		*p = nullptr;
 	}
 
+	// The flat layout removes the area from its split tree when the area
+	// is unparented, so there are no splitters to clean up
+	if (!Splitter)
+	{
+		goto emitAndExit;
+	}
+
 	// If splitter has more than 1 widgets, we are finished and can leave
 	if (Splitter->count() >  1)
 	{
@@ -1457,7 +1916,7 @@ void CDockContainerWidget::removeDockArea(CDockAreaWidget* area)
 	else if (Splitter->count() == 1)
 	{
         ADS_PRINT("Replacing splitter with content");
-		QSplitter* ParentSplitter = internal::findParent<QSplitter*>(Splitter);
+		QSplitter* ParentSplitter = internal::parentSplitter<QSplitter*>(Splitter);
 		auto Sizes = ParentSplitter->sizes();
 		QWidget* widget = Splitter->widget(0);
 		widget->setParent(this);
@@ -1586,7 +2045,7 @@ void CDockContainerWidget::dropFloatingWidget(CFloatingDockContainer* FloatingWi
 
 	if (Dropped)
 	{
-		FloatingWidget->deleteLater();
+		d->DockManager->releaseFloatingWidget(FloatingWidget);
 
 		// If we dropped a floating widget with only one single dock widget, then we
 		// drop a top level widget that changes from floating to docked now
@@ -1663,7 +2122,14 @@ void CDockContainerWidget::saveState(QXmlStreamWriter& s) const
 		s.writeTextElement("Geometry", Geometry.toHex(' '));
 #endif
 	}
-	d->saveChildNodesState(s, d->RootSplitter);
+	if (d->FlatLayoutWidget)
+	{
+		d->saveFlatNodeState(s, d->flatLayout()->root());
+	}
+	else
+	{
+		d->saveChildNodesState(s, d->RootSplitter);
+	}
 	s.writeEndElement();
 }
 
@@ -1709,6 +2175,25 @@ bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
         }
 	}
 
+	// In testing mode nothing is created, so the splitter code can parse
+	// the state for both layout engines
+	if (d->FlatLayoutWidget && !Testing)
+	{
+		CDockFlatLayoutNode Root;
+		if (!d->restoreFlatChildNodes(s, Root))
+		{
+			RE_LOG_ERROR("Unable restore child");
+			return false;
+		}
+
+		auto NewFlatLayoutWidget = d->newFlatLayoutWidget();
+		NewFlatLayoutWidget->flatLayout()->setRoot(Root);
+		delete d->Layout->replaceWidget(d->FlatLayoutWidget, NewFlatLayoutWidget);
+		d->FlatLayoutWidget->deleteLater();
+		d->FlatLayoutWidget = NewFlatLayoutWidget;
+		return true;
+	}
+
 	if (!d->restoreChildNodes(s, NewRootSplitter, Testing))
 	{
         RE_LOG_ERROR("Unable restore child");
@@ -1736,6 +2221,56 @@ bool CDockContainerWidget::restoreState(CDockingStateReader& s, bool Testing)
 }
 
 
+//============================================================================
+bool CDockContainerWidget::buildLayout(const CDockLayoutNode& Root)
+{
+	if (!d->DockAreas.isEmpty())
+	{
+		qWarning("CDockContainerWidget::buildLayout() is only possible for empty containers");
+		return false;
+	}
+
+	auto RootNode = Root;
+	if (CDockLayoutNode::AreaNode == Root.type())
+	{
+		RootNode = CDockLayoutNode::splitter(Qt::Horizontal, {Root});
+	}
+
+	d->VisibleDockAreaCount = -1;// invalidate the dock area count
+	if (d->FlatLayoutWidget)
+	{
+		CDockFlatLayoutNode FlatRoot;
+		if (!d->buildFlatLayoutNode(RootNode, FlatRoot))
+		{
+			return true;
+		}
+		d->flatLayout()->setRoot(FlatRoot);
+	}
+	else
+	{
+		auto NewRootSplitter = qobject_cast<QSplitter*>(d->buildLayoutNode(RootNode));
+		if (!NewRootSplitter)
+		{
+			return true;
+		}
+
+		d->Layout->replaceWidget(d->RootSplitter, NewRootSplitter);
+		QSplitter* OldRoot = d->RootSplitter;
+		d->RootSplitter = NewRootSplitter;
+		OldRoot->deleteLater();
+	}
+
+	// The title bar visibility depends on the number of dock areas, so it
+	// can only be updated when all dock areas exist
+	for (auto DockArea : d->DockAreas)
+	{
+		DockArea->updateTitleBarVisibility();
+	}
+	d->emitDockAreasAdded();
+	return true;
+}
+
+
 //============================================================================
 QSplitter* CDockContainerWidget::rootSplitter() const
 {
@@ -1743,11 +2278,59 @@ QSplitter* CDockContainerWidget::rootSplitter() const
 }
 
 
+//============================================================================
+CDockFlatLayoutWidget* CDockContainerWidget::flatLayoutWidget() const
+{
+	return d->FlatLayoutWidget;
+}
+
+
+//============================================================================
+void CDockContainerWidget::resetForReuse()
+{
+	// All dock areas have been moved into other containers, so we only
+	// drop the connections and references to them
+	for (auto DockArea : d->DockAreas)
+	{
+		DockArea->disconnect(this);
+	}
+	d->DockAreas.clear();
+	std::fill(std::begin(d->LastAddedAreaCache), std::end(d->LastAddedAreaCache), nullptr);
+	d->VisibleDockAreaCount = -1;
+	d->BulkInsertionDepth = 0;
+	d->PendingEqualSplits.clear();
+
+	// The drop target container has taken the split tree of the flat
+	// layout, so the empty host widget can be reused as it is
+	if (d->FlatLayoutWidget)
+	{
+		return;
+	}
+
+	// The root splitter is either moved into the drop target container or
+	// it is an empty splitter that is still owned by this container
+	if (d->RootSplitter && d->RootSplitter->parentWidget() == this)
+	{
+		d->Layout->removeWidget(d->RootSplitter);
+		d->RootSplitter->deleteLater();
+	}
+	d->RootSplitter = nullptr;
+	createRootSplitter();
+}
+
+
 //============================================================================
 void CDockContainerWidget::createRootSplitter()
 {
-	if (d->RootSplitter)
+	if (d->RootSplitter || d->FlatLayoutWidget)
+	{
+		return;
+	}
+
+	if (CDockManager::testPerformanceFlag(CDockManager::FlatLayoutEngine))
 	{
+		d->FlatLayoutWidget = d->newFlatLayoutWidget();
+		d->Layout->addWidget(d->FlatLayoutWidget);
 		return;
 	}
 	d->RootSplitter = d->newSplitter(Qt::Horizontal);
@@ -1759,9 +2342,21 @@ void CDockContainerWidget::createRootSplitter()
 void CDockContainerWidget::dumpLayout()
 {
 #if (ADS_DEBUG_LEVEL > 0)
+	if (d->DockManager && d->DockManager->isUpdating())
+	{
+		return;
+	}
+
 	qDebug("\n\nDumping layout --------------------------");
 	std::cout << "\n\nDumping layout --------------------------" << std::endl;
-	d->dumpRecursive(0, d->RootSplitter);
+	if (d->FlatLayoutWidget)
+	{
+		d->dumpFlatRecursive(0, d->flatLayout()->root());
+	}
+	else
+	{
+		d->dumpRecursive(0, d->RootSplitter);
+	}
 	qDebug("--------------------------\n\n");
 	std::cout << "--------------------------\n\n" << std::endl;
 #endif
@@ -1857,7 +2452,8 @@ CDockWidget::DockWidgetFeatures CDockContainerWidget::features() const
 //============================================================================
 CFloatingDockContainer* CDockContainerWidget::floatingWidget() const
 {
-	return internal::findParent<CFloatingDockContainer*>(this);
+	Q_ASSERT(d->FloatingWidget == internal::findParent<CFloatingDockContainer*>(this));
+	return d->FloatingWidget;
 }
 
 
@@ -50,6 +50,8 @@ struct FloatingDockContainerPrivate;
 class CFloatingDragPreview;
 struct FloatingDragPreviewPrivate;
 class CDockingStateReader;
+class CDockLayoutNode;
+class CDockFlatLayoutWidget;
 
 /**
  * Container that manages a number of dock areas with single dock widgets
@@ -81,10 +83,19 @@ protected:
 	virtual bool event(QEvent *e) override;
 
 	/**
-	 * Access function for the internal root splitter
+	 * Access function for the internal root splitter.
+	 * Returns a nullptr if the CDockManager::FlatLayoutEngine performance
+	 * flag is set
 	 */
 	QSplitter* rootSplitter() const;
 
+	/**
+	 * Access function for the host widget of the flat layout.
+	 * Returns a nullptr if the CDockManager::FlatLayoutEngine performance
+	 * flag is not set
+	 */
+	CDockFlatLayoutWidget* flatLayoutWidget() const;
+
 	/**
 	 * Helper function for creation of the root splitter
 	 */
@@ -127,6 +138,14 @@ protected:
 	 */
 	bool restoreState(CDockingStateReader& Stream, bool Testing);
 
+	/**
+	 * Builds the splitter tree described by the given layout node in one
+	 * pass. The dock widgets of the layout are looked up in the dock
+	 * manager. The function fails if the container already contains dock
+	 * areas.
+	 */
+	bool buildLayout(const CDockLayoutNode& Root);
+
 	/**
 	 * This function returns the last added dock area widget for the given
 	 * area identifier or 0 if no dock area widget has been added for the given
@@ -161,6 +180,27 @@ protected:
      */
     void updateSplitterHandles(QSplitter* splitter);
 
+	/**
+	 * Starts a bulk insertion.
+	 * Until the outermost bulk insertion ends, splitter sizes are not
+	 * redistributed on each insertion if the
+	 * CDockManager::EqualSplitOnInsertion flag is set.
+	 */
+	void beginBulkInsertion();
+
+	/**
+	 * Ends a bulk insertion and distributes the sizes of all splitters
+	 * that received new dock areas once
+	 */
+	void endBulkInsertion();
+
+	/**
+	 * Clears this container after all of its dock areas have been dropped
+	 * into other containers. This is used by the floating widget pool to
+	 * reuse the container of a floating widget
+	 */
+	void resetForReuse();
+
 public:
 	/**
 	 * Default Constructor
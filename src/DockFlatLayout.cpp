@@ -0,0 +1,1423 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockFlatLayout.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CDockFlatLayout and CDockFlatLayoutWidget classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockFlatLayout.h"
+
+#include <QApplication>
+#include <QHash>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QPointer>
+#include <QRubberBand>
+#include <QStyle>
+#include <QStyleOption>
+#include <QTimer>
+#include <QVector>
+
+#include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockStyle.h"
+#include "DockWidget.h"
+
+namespace ads
+{
+/**
+ * Returns the extent of the given size along the given orientation
+ */
+static int pick(Qt::Orientation Orientation, const QSize& Size)
+{
+	return (Orientation == Qt::Horizontal) ? Size.width() : Size.height();
+}
+
+
+/**
+ * Returns the extent of the given size across the given orientation
+ */
+static int trans(Qt::Orientation Orientation, const QSize& Size)
+{
+	return (Orientation == Qt::Horizontal) ? Size.height() : Size.width();
+}
+
+
+/**
+ * Creates a size from the extents along and across the given orientation
+ */
+static QSize makeSize(Qt::Orientation Orientation, int Along, int Across)
+{
+	return (Orientation == Qt::Horizontal) ? QSize(Along, Across) : QSize(Across, Along);
+}
+
+
+/**
+ * Adds two extents without exceeding QWIDGETSIZE_MAX
+ */
+static int boundedSum(int a, int b)
+{
+	return int(qMin<qint64>(qint64(a) + b, QWIDGETSIZE_MAX));
+}
+
+
+/**
+ * Searches the leaf of the given widget and stores the child indexes from
+ * the given node to the leaf in Path
+ */
+static bool findPath(const CDockFlatLayoutNode& Node, const QWidget* Widget,
+	QVector<int>& Path)
+{
+	for (int i = 0; i < Node.Children.count(); ++i)
+	{
+		const auto& Child = Node.Children[i];
+		Path.append(i);
+		if (Child.Widget == Widget || (!Child.isLeaf() && findPath(Child, Widget, Path)))
+		{
+			return true;
+		}
+		Path.removeLast();
+	}
+
+	return false;
+}
+
+
+/**
+ * Returns the node at the given depth of the given path
+ */
+static CDockFlatLayoutNode& nodeAt(CDockFlatLayoutNode& Root,
+	const QVector<int>& Path, int Depth)
+{
+	auto Node = &Root;
+	for (int i = 0; i < Depth; ++i)
+	{
+		Node = &Node->Children[Path[i]];
+	}
+	return *Node;
+}
+
+
+/**
+ * Returns the preferred extent of the given tree along the given orientation
+ */
+static int nodeSizeHint(const CDockFlatLayoutNode& Node, Qt::Orientation Orientation)
+{
+	if (Node.isLeaf())
+	{
+		return pick(Orientation, Node.Widget->sizeHint());
+	}
+
+	int Result = 0;
+	for (const auto& Child : Node.Children)
+	{
+		int Hint = nodeSizeHint(Child, Orientation);
+		Result = (Node.Orientation == Orientation) ? Result + Hint : qMax(Result, Hint);
+	}
+	return Result;
+}
+
+
+/**
+ * Scales the sizes of the given nodes proportionally to the given total
+ * size. Nodes without a size get their preferred size first. If Total is
+ * not positive, only the missing sizes are initialized.
+ */
+static void scaleSizes(QList<CDockFlatLayoutNode>& Nodes, Qt::Orientation Orientation,
+	int Total)
+{
+	qint64 Sum = 0;
+	for (auto& Node : Nodes)
+	{
+		if (Node.Size <= 0)
+		{
+			Node.Size = qMax(1, nodeSizeHint(Node, Orientation));
+		}
+		Sum += Node.Size;
+	}
+
+	if (Total <= 0)
+	{
+		return;
+	}
+
+	int Remaining = Total;
+	for (int i = 0; i < Nodes.count(); ++i)
+	{
+		auto& Node = Nodes[i];
+		Node.Size = (i == Nodes.count() - 1) ? Remaining : int(qint64(Total) * Node.Size / Sum);
+		Remaining -= Node.Size;
+	}
+}
+
+
+//============================================================================
+bool CDockFlatLayoutNode::hasVisibleContent() const
+{
+	if (isLeaf())
+	{
+		return !Widget->isHidden();
+	}
+
+	for (const auto& Child : Children)
+	{
+		if (Child.hasVisibleContent())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/**
+ * Private data class of CDockFlatLayout class (pimpl)
+ */
+struct DockFlatLayoutPrivate
+{
+	/**
+	 * Solver data of one node. The items are stored in pre-order of the
+	 * split tree, so the children of a split node follow the node and each
+	 * subtree is a contiguous range.
+	 */
+	struct SolverItem
+	{
+		Qt::Orientation Orientation = Qt::Horizontal;
+		QWidget* Widget = nullptr;
+		QLayoutItem* LayoutItem = nullptr;
+		int SubtreeSize = 1; ///< number of items of the subtree including this item
+		int Size = 0;
+		bool Visible = false;
+		bool Stretch = false; ///< the node contains the central widget area
+		QSize Min;
+		QSize Max;
+		QSize Hint;
+		QRect Rect;
+	};
+
+	/**
+	 * Handle between two visible child nodes of a split node
+	 */
+	struct SolverHandle
+	{
+		QRect Rect;
+		Qt::Orientation Orientation;
+		int First;
+		int Second;
+	};
+
+	CDockFlatLayout* _this;
+	CDockFlatLayoutNode Root;
+	QList<QLayoutItem*> Items;
+	QVector<SolverItem> SolverItems;
+	QVector<SolverHandle> Handles;
+	int HandleWidth = 2;
+	bool TreeDirty = true;
+	bool ConstraintsDirty = true;
+
+	/**
+	 * Private data constructor
+	 */
+	DockFlatLayoutPrivate(CDockFlatLayout* _public) : _this(_public) {}
+
+	/**
+	 * Marks the solver items as outdated after a change of the split tree
+	 */
+	void treeChanged()
+	{
+		TreeDirty = true;
+		_this->invalidate();
+	}
+
+	/**
+	 * Appends the solver items of the given subtree and returns the number
+	 * of appended items
+	 */
+	int collect(const CDockFlatLayoutNode& Node,
+		const QHash<QWidget*, QLayoutItem*>& LayoutItems);
+
+	/**
+	 * Rebuilds the solver items if the tree has changed and computes the
+	 * minimum, maximum and preferred sizes of all nodes bottom up
+	 */
+	void updateConstraints();
+
+	/**
+	 * Distributes the rect of the split node with the given index to its
+	 * visible children and adds the handles between them
+	 */
+	void distribute(int Index);
+
+	/**
+	 * Distributes the given delta to the given items proportionally to
+	 * their sizes and returns the part that could not be distributed
+	 * because of the size constraints
+	 */
+	int distributeDelta(QVector<int> Candidates, int Delta, Qt::Orientation Orientation);
+
+	/**
+	 * Solves the sizes of all nodes for the given rect and applies them to
+	 * the content widgets
+	 */
+	void solve(const QRect& Rect);
+
+	/**
+	 * Copies the solved sizes back into the split tree
+	 */
+	int writeBack(CDockFlatLayoutNode& Node, int Index);
+
+	/**
+	 * Adds all content widgets of the given tree to the layout
+	 */
+	void addLeafWidgets(const CDockFlatLayoutNode& Node);
+
+	/**
+	 * Removes the leaf of the given widget from the split tree
+	 */
+	void removeLeaf(QWidget* Widget);
+
+	/**
+	 * Inserts the given node into the given area of the Target widget
+	 */
+	void insertNode(const CDockFlatLayoutNode& Node, DockWidgetArea Area, QWidget* Target);
+
+	/**
+	 * Returns the layout direction of the parent widget
+	 */
+	Qt::LayoutDirection direction() const
+	{
+		auto Parent = _this->parentWidget();
+		return Parent ? Parent->layoutDirection() : QApplication::layoutDirection();
+	}
+
+	/**
+	 * Maps the given rect from the left to right solver coordinates to the
+	 * coordinates of the parent widget
+	 */
+	QRect visualRect(const QRect& Rect) const
+	{
+		return QStyle::visualRect(direction(), _this->geometry(), Rect);
+	}
+};
+// struct DockFlatLayoutPrivate
+
+
+//============================================================================
+int DockFlatLayoutPrivate::collect(const CDockFlatLayoutNode& Node,
+	const QHash<QWidget*, QLayoutItem*>& LayoutItems)
+{
+	int Index = SolverItems.count();
+	SolverItem Item;
+	Item.Orientation = Node.Orientation;
+	Item.Widget = Node.Widget;
+	Item.LayoutItem = Node.Widget ? LayoutItems.value(Node.Widget) : nullptr;
+	Item.Size = Node.Size;
+	SolverItems.append(Item);
+
+	for (const auto& Child : Node.Children)
+	{
+		int Count = collect(Child, LayoutItems);
+		SolverItems[Index].SubtreeSize += Count;
+	}
+	return SolverItems[Index].SubtreeSize;
+}
+
+
+//============================================================================
+void DockFlatLayoutPrivate::updateConstraints()
+{
+	if (TreeDirty)
+	{
+		QHash<QWidget*, QLayoutItem*> LayoutItems;
+		LayoutItems.reserve(Items.count());
+		for (auto Item : Items)
+		{
+			LayoutItems.insert(Item->widget(), Item);
+		}
+
+		SolverItems.clear();
+		Handles.clear();
+		collect(Root, LayoutItems);
+		TreeDirty = false;
+		ConstraintsDirty = true;
+	}
+
+	if (!ConstraintsDirty)
+	{
+		return;
+	}
+
+	// The children of a split node follow the node in pre-order, so the
+	// reverse iteration visits all children before their parent
+	for (int i = SolverItems.count() - 1; i >= 0; --i)
+	{
+		auto& Item = SolverItems[i];
+		if (Item.Widget)
+		{
+			Item.Visible = !Item.Widget->isHidden();
+			Item.Min = Item.LayoutItem ? Item.LayoutItem->minimumSize() : QSize(0, 0);
+			Item.Max = Item.LayoutItem ? Item.LayoutItem->maximumSize() : QSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+			Item.Hint = Item.LayoutItem ? Item.LayoutItem->sizeHint() : QSize(0, 0);
+			auto DockArea = qobject_cast<CDockAreaWidget*>(Item.Widget);
+			Item.Stretch = DockArea && DockArea->isCentralWidgetArea();
+			continue;
+		}
+
+		auto Orientation = Item.Orientation;
+		int MinAlong = 0, MaxAlong = 0, HintAlong = 0;
+		int MinAcross = 0, MaxAcross = QWIDGETSIZE_MAX, HintAcross = 0;
+		int VisibleCount = 0;
+		Item.Stretch = false;
+		for (int j = i + 1; j < i + Item.SubtreeSize; j += SolverItems[j].SubtreeSize)
+		{
+			const auto& Child = SolverItems[j];
+			if (!Child.Visible)
+			{
+				continue;
+			}
+
+			++VisibleCount;
+			Item.Stretch |= Child.Stretch;
+			MinAlong += pick(Orientation, Child.Min);
+			MaxAlong = boundedSum(MaxAlong, pick(Orientation, Child.Max));
+			HintAlong += pick(Orientation, Child.Hint);
+			MinAcross = qMax(MinAcross, trans(Orientation, Child.Min));
+			MaxAcross = qMin(MaxAcross, trans(Orientation, Child.Max));
+			HintAcross = qMax(HintAcross, trans(Orientation, Child.Hint));
+		}
+
+		int HandleSpace = HandleWidth * qMax(0, VisibleCount - 1);
+		Item.Visible = VisibleCount > 0;
+		Item.Min = makeSize(Orientation, MinAlong + HandleSpace, MinAcross);
+		Item.Max = makeSize(Orientation, boundedSum(MaxAlong, HandleSpace), qMax(MinAcross, MaxAcross));
+		Item.Hint = makeSize(Orientation, HintAlong + HandleSpace, HintAcross);
+	}
+	ConstraintsDirty = false;
+}
+
+
+//============================================================================
+int DockFlatLayoutPrivate::distributeDelta(QVector<int> Candidates, int Delta,
+	Qt::Orientation Orientation)
+{
+	while (Delta && !Candidates.isEmpty())
+	{
+		qint64 Weight = 0;
+		for (auto Index : Candidates)
+		{
+			Weight += SolverItems[Index].Size;
+		}
+
+		int Remaining = Delta;
+		QVector<int> Unbounded;
+		for (int k = 0; k < Candidates.count(); ++k)
+		{
+			auto& Item = SolverItems[Candidates[k]];
+			int Share;
+			if (k == Candidates.count() - 1)
+			{
+				Share = Remaining;
+			}
+			else
+			{
+				Share = Weight ? int(qint64(Delta) * Item.Size / Weight) : Delta / Candidates.count();
+			}
+
+			int Wanted = Item.Size + Share;
+			int NewSize = qBound(pick(Orientation, Item.Min), Wanted,
+				qMax(pick(Orientation, Item.Min), pick(Orientation, Item.Max)));
+			Remaining -= NewSize - Item.Size;
+			Item.Size = NewSize;
+			if (NewSize == Wanted)
+			{
+				Unbounded.append(Candidates[k]);
+			}
+		}
+
+		// Stop if all candidates are at their limits
+		if (Remaining == Delta)
+		{
+			break;
+		}
+		Delta = Remaining;
+		Candidates = Unbounded;
+	}
+
+	return Delta;
+}
+
+
+//============================================================================
+void DockFlatLayoutPrivate::distribute(int Index)
+{
+	const auto Orientation = SolverItems[Index].Orientation;
+	const QRect Rect = SolverItems[Index].Rect;
+	const int End = Index + SolverItems[Index].SubtreeSize;
+	QVector<int> VisibleItems;
+	QVector<int> StretchItems;
+	for (int j = Index + 1; j < End; j += SolverItems[j].SubtreeSize)
+	{
+		const auto& Child = SolverItems[j];
+		if (!Child.Visible)
+		{
+			continue;
+		}
+
+		VisibleItems.append(j);
+		if (Child.Stretch)
+		{
+			StretchItems.append(j);
+		}
+	}
+
+	if (VisibleItems.isEmpty())
+	{
+		return;
+	}
+
+	int Available = pick(Orientation, Rect.size()) - HandleWidth * (VisibleItems.count() - 1);
+	int Used = 0;
+	for (auto j : VisibleItems)
+	{
+		auto& Child = SolverItems[j];
+		int Min = pick(Orientation, Child.Min);
+		Child.Size = qBound(Min, Child.Size, qMax(Min, pick(Orientation, Child.Max)));
+		Used += Child.Size;
+	}
+
+	// Like the stretch factors of the splitters, space changes go to the
+	// nodes that contain the central widget first
+	int Delta = distributeDelta(StretchItems, Available - Used, Orientation);
+	Delta = distributeDelta(VisibleItems, Delta, Orientation);
+	// If the constraints can not be satisfied, the last node takes the rest
+	auto& LastItem = SolverItems[VisibleItems.last()];
+	LastItem.Size = qMax(0, LastItem.Size + Delta);
+
+	int Pos = (Orientation == Qt::Horizontal) ? Rect.left() : Rect.top();
+	for (int k = 0; k < VisibleItems.count(); ++k)
+	{
+		auto& Child = SolverItems[VisibleItems[k]];
+		if (Orientation == Qt::Horizontal)
+		{
+			Child.Rect = QRect(Pos, Rect.top(), Child.Size, Rect.height());
+		}
+		else
+		{
+			Child.Rect = QRect(Rect.left(), Pos, Rect.width(), Child.Size);
+		}
+		Pos += Child.Size;
+
+		if (k == VisibleItems.count() - 1)
+		{
+			break;
+		}
+
+		SolverHandle Handle;
+		Handle.Rect = (Orientation == Qt::Horizontal)
+			? QRect(Pos, Rect.top(), HandleWidth, Rect.height())
+			: QRect(Rect.left(), Pos, Rect.width(), HandleWidth);
+		Handle.Orientation = Orientation;
+		Handle.First = VisibleItems[k];
+		Handle.Second = VisibleItems[k + 1];
+		Handles.append(Handle);
+		Pos += HandleWidth;
+	}
+}
+
+
+//============================================================================
+void DockFlatLayoutPrivate::solve(const QRect& Rect)
+{
+	updateConstraints();
+	Handles.clear();
+	SolverItems[0].Rect = Rect;
+	// One top down pass - each split node distributes its rect to its
+	// children before they are visited
+	for (int i = 0; i < SolverItems.count(); ++i)
+	{
+		const auto& Item = SolverItems[i];
+		if (!Item.Visible)
+		{
+			continue;
+		}
+
+		if (!Item.Widget)
+		{
+			distribute(i);
+		}
+		else if (Item.LayoutItem)
+		{
+			Item.LayoutItem->setGeometry(visualRect(Item.Rect));
+		}
+	}
+
+	writeBack(Root, 0);
+}
+
+
+//============================================================================
+int DockFlatLayoutPrivate::writeBack(CDockFlatLayoutNode& Node, int Index)
+{
+	Node.Size = SolverItems[Index].Size;
+	int Next = Index + 1;
+	for (auto& Child : Node.Children)
+	{
+		Next = writeBack(Child, Next);
+	}
+	return Next;
+}
+
+
+//============================================================================
+void DockFlatLayoutPrivate::addLeafWidgets(const CDockFlatLayoutNode& Node)
+{
+	if (Node.isLeaf())
+	{
+		_this->addChildWidget(Node.Widget);
+		Items.append(new QWidgetItem(Node.Widget));
+		return;
+	}
+
+	for (const auto& Child : Node.Children)
+	{
+		addLeafWidgets(Child);
+	}
+}
+
+
+//============================================================================
+void DockFlatLayoutPrivate::removeLeaf(QWidget* Widget)
+{
+	QVector<int> Path;
+	if (!findPath(Root, Widget, Path))
+	{
+		return;
+	}
+
+	int Depth = Path.count() - 1;
+	nodeAt(Root, Path, Depth).Children.removeAt(Path[Depth]);
+
+	// Split nodes with only one child are replaced by their child like
+	// CDockContainerWidget replaces splitters with only one widget
+	while (Depth > 0)
+	{
+		auto& Parent = nodeAt(Root, Path, Depth);
+		if (Parent.Children.count() > 1)
+		{
+			break;
+		}
+
+		auto& GrandParent = nodeAt(Root, Path, Depth - 1);
+		if (!Parent.Children.isEmpty())
+		{
+			auto Child = Parent.Children.first();
+			Child.Size = Parent.Size;
+			GrandParent.Children[Path[Depth - 1]] = Child;
+			break;
+		}
+
+		GrandParent.Children.removeAt(Path[Depth - 1]);
+		--Depth;
+	}
+
+	if (Root.Children.count() == 1 && !Root.Children.first().isLeaf())
+	{
+		auto Child = Root.Children.first();
+		Root = Child;
+	}
+	treeChanged();
+}
+
+
+//============================================================================
+void DockFlatLayoutPrivate::insertNode(const CDockFlatLayoutNode& Node,
+	DockWidgetArea Area, QWidget* Target)
+{
+	auto InsertParam = internal::dockAreaInsertParameters(Area);
+	auto Orientation = InsertParam.orientation();
+	// A split node with the insertion orientation is merged into the node it
+	// is inserted into
+	QList<CDockFlatLayoutNode> Nodes;
+	if (!Node.isLeaf() && (Node.Orientation == Orientation || Node.Children.count() == 1))
+	{
+		Nodes = Node.Children;
+	}
+	else
+	{
+		Nodes.append(Node);
+	}
+
+	if (Nodes.isEmpty())
+	{
+		return;
+	}
+	addLeafWidgets(Node);
+
+	QVector<int> Path;
+	if (!Target || !findPath(Root, Target, Path))
+	{
+		// As long as the root node has only one child, we can adjust its
+		// orientation
+		if (Root.Children.count() <= 1)
+		{
+			Root.Orientation = Orientation;
+		}
+
+		if (Root.Orientation != Orientation)
+		{
+			CDockFlatLayoutNode NewRoot;
+			NewRoot.Orientation = Orientation;
+			NewRoot.Children.append(Root);
+			NewRoot.Children.first().Size = pick(Orientation, _this->geometry().size());
+			Root = NewRoot;
+		}
+
+		scaleSizes(Nodes, Orientation, 0);
+		int Index = InsertParam.append() ? Root.Children.count() : 0;
+		for (const auto& NewNode : Nodes)
+		{
+			Root.Children.insert(Index++, NewNode);
+		}
+		treeChanged();
+		return;
+	}
+
+	int Depth = Path.count() - 1;
+	auto& Parent = nodeAt(Root, Path, Depth);
+	int Index = Path[Depth];
+	auto& TargetNode = Parent.Children[Index];
+	if (Parent.Orientation == Orientation)
+	{
+		// The target gives half of its space to the new nodes
+		int TargetSize = (TargetNode.Size > 0) ? TargetNode.Size : nodeSizeHint(TargetNode, Orientation);
+		int Size = qMax(0, TargetSize - HandleWidth) / 2;
+		TargetNode.Size = Size;
+		scaleSizes(Nodes, Orientation, Size);
+		Index += InsertParam.insertOffset();
+		for (const auto& NewNode : Nodes)
+		{
+			Parent.Children.insert(Index++, NewNode);
+		}
+	}
+	else
+	{
+		// The target is replaced by a new split node that contains the
+		// target and the new nodes
+		int TargetSize = pick(Orientation, Target->size());
+		if (TargetSize <= 0)
+		{
+			TargetSize = nodeSizeHint(TargetNode, Orientation);
+		}
+
+		CDockFlatLayoutNode SplitNode;
+		SplitNode.Orientation = Orientation;
+		SplitNode.Size = TargetNode.Size;
+		SplitNode.Children.append(TargetNode);
+		SplitNode.Children.first().Size = TargetSize - TargetSize / 2;
+		scaleSizes(Nodes, Orientation, TargetSize / 2);
+		int SplitIndex = InsertParam.append() ? 1 : 0;
+		for (const auto& NewNode : Nodes)
+		{
+			SplitNode.Children.insert(SplitIndex++, NewNode);
+		}
+		TargetNode = SplitNode;
+	}
+	treeChanged();
+}
+
+
+//============================================================================
+CDockFlatLayout::CDockFlatLayout(QWidget* Parent) :
+	Super(Parent),
+	d(new DockFlatLayoutPrivate(this))
+{
+	setContentsMargins(0, 0, 0, 0);
+	setSpacing(0);
+}
+
+
+//============================================================================
+CDockFlatLayout::~CDockFlatLayout()
+{
+	qDeleteAll(d->Items);
+	delete d;
+}
+
+
+//============================================================================
+void CDockFlatLayout::setHandleWidth(int Width)
+{
+	d->HandleWidth = qMax(0, Width);
+	invalidate();
+}
+
+
+//============================================================================
+int CDockFlatLayout::handleWidth() const
+{
+	return d->HandleWidth;
+}
+
+
+//============================================================================
+const CDockFlatLayoutNode& CDockFlatLayout::root() const
+{
+	return d->Root;
+}
+
+
+//============================================================================
+void CDockFlatLayout::setRoot(const CDockFlatLayoutNode& Root)
+{
+	qDeleteAll(d->Items);
+	d->Items.clear();
+	d->Root = CDockFlatLayoutNode();
+	if (Root.isLeaf())
+	{
+		d->Root.Children.append(Root);
+	}
+	else
+	{
+		d->Root = Root;
+	}
+	d->addLeafWidgets(d->Root);
+	d->treeChanged();
+}
+
+
+//============================================================================
+CDockFlatLayoutNode CDockFlatLayout::takeRoot()
+{
+	auto Result = d->Root;
+	// If the tree is not merged into the target node, its size is its
+	// extent across its own orientation
+	Result.Size = trans(Result.Orientation, geometry().size());
+	qDeleteAll(d->Items);
+	d->Items.clear();
+	d->Root = CDockFlatLayoutNode();
+	d->treeChanged();
+	return Result;
+}
+
+
+//============================================================================
+void CDockFlatLayout::insertWidget(QWidget* Widget, DockWidgetArea Area, QWidget* Target)
+{
+	if (indexOf(Widget) >= 0)
+	{
+		removeWidget(Widget);
+	}
+
+	CDockFlatLayoutNode Node;
+	Node.Widget = Widget;
+	d->insertNode(Node, Area, Target);
+}
+
+
+//============================================================================
+void CDockFlatLayout::insertTree(const CDockFlatLayoutNode& Tree, DockWidgetArea Area,
+	QWidget* Target)
+{
+	d->insertNode(Tree, Area, Target);
+}
+
+
+//============================================================================
+void CDockFlatLayout::distributeEvenly(QWidget* Widget)
+{
+	QVector<int> Path;
+	if (!findPath(d->Root, Widget, Path))
+	{
+		return;
+	}
+
+	auto& Parent = nodeAt(d->Root, Path, Path.count() - 1);
+	int Total = 0;
+	int VisibleCount = 0;
+	for (const auto& Child : Parent.Children)
+	{
+		if (Child.hasVisibleContent())
+		{
+			Total += Child.Size;
+			++VisibleCount;
+		}
+	}
+
+	for (auto& Child : Parent.Children)
+	{
+		if (Child.hasVisibleContent())
+		{
+			Child.Size = Total / VisibleCount;
+		}
+	}
+	d->treeChanged();
+}
+
+
+//============================================================================
+int CDockFlatLayout::handleCount() const
+{
+	return d->Handles.count();
+}
+
+
+//============================================================================
+QRect CDockFlatLayout::handleRect(int Handle) const
+{
+	return d->visualRect(d->Handles[Handle].Rect);
+}
+
+
+//============================================================================
+Qt::Orientation CDockFlatLayout::handleOrientation(int Handle) const
+{
+	return d->Handles[Handle].Orientation;
+}
+
+
+//============================================================================
+int CDockFlatLayout::handleAt(const QPoint& Pos) const
+{
+	for (int i = 0; i < d->Handles.count(); ++i)
+	{
+		if (handleRect(i).contains(Pos))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+
+//============================================================================
+QList<QWidget*> CDockFlatLayout::handleWidgets(int Handle) const
+{
+	QList<QWidget*> Result;
+	if (Handle < 0 || Handle >= d->Handles.count())
+	{
+		return Result;
+	}
+
+	const auto& SolverHandle = d->Handles[Handle];
+	for (auto Index : {SolverHandle.First, SolverHandle.Second})
+	{
+		int End = Index + d->SolverItems[Index].SubtreeSize;
+		for (int i = Index; i < End; ++i)
+		{
+			const auto& Item = d->SolverItems[i];
+			if (Item.Widget && Item.Visible)
+			{
+				Result.append(Item.Widget);
+			}
+		}
+	}
+
+	return Result;
+}
+
+
+//============================================================================
+void CDockFlatLayout::moveHandle(int Handle, int Offset)
+{
+	if (Handle < 0 || Handle >= d->Handles.count() || d->TreeDirty)
+	{
+		return;
+	}
+
+	const auto& SolverHandle = d->Handles[Handle];
+	auto Orientation = SolverHandle.Orientation;
+	if (Orientation == Qt::Horizontal && d->direction() == Qt::RightToLeft)
+	{
+		Offset = -Offset;
+	}
+
+	auto& First = d->SolverItems[SolverHandle.First];
+	auto& Second = d->SolverItems[SolverHandle.Second];
+	int Lower = qMax(pick(Orientation, First.Min) - First.Size,
+		Second.Size - pick(Orientation, Second.Max));
+	int Upper = qMin(pick(Orientation, First.Max) - First.Size,
+		Second.Size - pick(Orientation, Second.Min));
+	if (Lower > Upper)
+	{
+		return;
+	}
+
+	Offset = qBound(Lower, Offset, Upper);
+	if (!Offset)
+	{
+		return;
+	}
+
+	First.Size += Offset;
+	Second.Size -= Offset;
+	d->solve(contentsRect());
+	if (parentWidget())
+	{
+		parentWidget()->update();
+	}
+}
+
+
+//============================================================================
+void CDockFlatLayout::addItem(QLayoutItem* Item)
+{
+	// Only widgets are supported - they are appended to the root node
+	if (!Item->widget())
+	{
+		delete Item;
+		return;
+	}
+
+	d->Items.append(Item);
+	CDockFlatLayoutNode Node;
+	Node.Widget = Item->widget();
+	d->Root.Children.append(Node);
+	d->treeChanged();
+}
+
+
+//============================================================================
+QLayoutItem* CDockFlatLayout::itemAt(int Index) const
+{
+	return d->Items.value(Index);
+}
+
+
+//============================================================================
+QLayoutItem* CDockFlatLayout::takeAt(int Index)
+{
+	if (Index < 0 || Index >= d->Items.count())
+	{
+		return nullptr;
+	}
+
+	auto Item = d->Items.takeAt(Index);
+	d->removeLeaf(Item->widget());
+	return Item;
+}
+
+
+//============================================================================
+int CDockFlatLayout::count() const
+{
+	return d->Items.count();
+}
+
+
+//============================================================================
+QSize CDockFlatLayout::sizeHint() const
+{
+	d->updateConstraints();
+	return d->SolverItems[0].Hint;
+}
+
+
+//============================================================================
+QSize CDockFlatLayout::minimumSize() const
+{
+	d->updateConstraints();
+	return d->SolverItems[0].Min;
+}
+
+
+//============================================================================
+QSize CDockFlatLayout::maximumSize() const
+{
+	d->updateConstraints();
+	const auto& RootItem = d->SolverItems[0];
+	return RootItem.Visible ? RootItem.Max : QSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+}
+
+
+//============================================================================
+void CDockFlatLayout::setGeometry(const QRect& Rect)
+{
+	Super::setGeometry(Rect);
+	d->solve(contentsRect());
+	// The handles are painted by the parent widget
+	if (parentWidget())
+	{
+		parentWidget()->update();
+	}
+}
+
+
+//============================================================================
+void CDockFlatLayout::invalidate()
+{
+	d->ConstraintsDirty = true;
+	Super::invalidate();
+}
+
+
+/**
+ * Private data class of CDockFlatLayoutWidget class (pimpl)
+ */
+struct DockFlatLayoutWidgetPrivate
+{
+	CDockFlatLayoutWidget* _this;
+	CDockFlatLayout* Layout = nullptr;
+	int HoverHandle = -1;
+	int DragHandle = -1;
+	QPoint DragOffset;
+	QPoint PendingPos;
+	bool HasPendingPos = false;
+	bool OpaqueResize = true;
+	int OpaqueResizeInterval = 0;
+	QTimer ResizeTimer;
+	QRubberBand* RubberBand = nullptr;
+	QPointer<CDockManager> InteractionManager;
+	int InteractionId = 0;
+
+	/**
+	 * Private data constructor
+	 */
+	DockFlatLayoutWidgetPrivate(CDockFlatLayoutWidget* _public) : _this(_public) {}
+
+	/**
+	 * Returns true, if the dragged handle still exists
+	 */
+	bool isDragging() const
+	{
+		return DragHandle >= 0 && DragHandle < Layout->handleCount();
+	}
+
+	/**
+	 * Returns the offset of the dragged handle for the given mouse position
+	 */
+	int dragOffset(const QPoint& Pos) const
+	{
+		QPoint Offset = Pos - DragOffset - Layout->handleRect(DragHandle).topLeft();
+		return (Layout->handleOrientation(DragHandle) == Qt::Horizontal) ? Offset.x() : Offset.y();
+	}
+
+	/**
+	 * Moves the dragged handle to the pending position and restarts the
+	 * timer to delay the next move
+	 */
+	void applyPendingPos();
+
+	/**
+	 * Shows the rubber band at the pending position for non opaque resizing
+	 */
+	void updateRubberBand();
+
+	/**
+	 * Updates the hovered handle and the cursor
+	 */
+	void setHoverHandle(int Handle);
+
+	/**
+	 * Starts the interaction for a handle drag
+	 */
+	void beginHandleDrag();
+
+	/**
+	 * Finishes the interaction of a handle drag
+	 */
+	void endHandleDrag();
+};
+// struct DockFlatLayoutWidgetPrivate
+
+
+//============================================================================
+void DockFlatLayoutWidgetPrivate::applyPendingPos()
+{
+	if (!HasPendingPos || !isDragging())
+	{
+		return;
+	}
+
+	Layout->moveHandle(DragHandle, dragOffset(PendingPos));
+	HasPendingPos = false;
+	emit _this->handleMoved();
+	if (OpaqueResizeInterval > 0)
+	{
+		ResizeTimer.start(OpaqueResizeInterval);
+	}
+}
+
+
+//============================================================================
+void DockFlatLayoutWidgetPrivate::updateRubberBand()
+{
+	if (!RubberBand)
+	{
+		RubberBand = new QRubberBand(QRubberBand::Line, _this);
+	}
+
+	int Offset = dragOffset(PendingPos);
+	QRect Rect = Layout->handleRect(DragHandle);
+	if (Layout->handleOrientation(DragHandle) == Qt::Horizontal)
+	{
+		Rect.translate(Offset, 0);
+	}
+	else
+	{
+		Rect.translate(0, Offset);
+	}
+	RubberBand->setGeometry(Rect);
+	RubberBand->show();
+}
+
+
+//============================================================================
+void DockFlatLayoutWidgetPrivate::setHoverHandle(int Handle)
+{
+	if (Handle == HoverHandle)
+	{
+		return;
+	}
+
+	HoverHandle = Handle;
+	if (Handle < 0)
+	{
+		_this->unsetCursor();
+	}
+	else
+	{
+		_this->setCursor((Layout->handleOrientation(Handle) == Qt::Horizontal)
+			? Qt::SplitHCursor : Qt::SplitVCursor);
+	}
+	_this->update();
+}
+
+
+//============================================================================
+void DockFlatLayoutWidgetPrivate::beginHandleDrag()
+{
+	if (InteractionId)
+	{
+		return;
+	}
+
+	QList<CDockWidget*> DockWidgets;
+	for (auto Widget : Layout->handleWidgets(DragHandle))
+	{
+		auto DockArea = qobject_cast<CDockAreaWidget*>(Widget);
+		if (DockArea && DockArea->currentDockWidget())
+		{
+			DockWidgets.append(DockArea->currentDockWidget());
+		}
+	}
+
+	if (DockWidgets.isEmpty() || !DockWidgets.first()->dockManager())
+	{
+		return;
+	}
+
+	InteractionManager = DockWidgets.first()->dockManager();
+	InteractionId = InteractionManager->beginInteraction(DockWidgets);
+}
+
+
+//============================================================================
+void DockFlatLayoutWidgetPrivate::endHandleDrag()
+{
+	if (InteractionManager)
+	{
+		InteractionManager->endInteraction(InteractionId);
+	}
+	InteractionManager = nullptr;
+	InteractionId = 0;
+}
+
+
+//============================================================================
+CDockFlatLayoutWidget::CDockFlatLayoutWidget(QWidget* Parent) :
+	Super(Parent),
+	d(new DockFlatLayoutWidgetPrivate(this))
+{
+	d->Layout = new CDockFlatLayout(this);
+	d->ResizeTimer.setSingleShot(true);
+	connect(&d->ResizeTimer, &QTimer::timeout, this, [this]() { d->applyPendingPos(); });
+	setMouseTracking(true);
+	CDockStyle::applyTo(this);
+}
+
+
+//============================================================================
+CDockFlatLayoutWidget::~CDockFlatLayoutWidget()
+{
+	d->endHandleDrag();
+	delete d;
+}
+
+
+//============================================================================
+CDockFlatLayout* CDockFlatLayoutWidget::flatLayout() const
+{
+	return d->Layout;
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::setOpaqueResize(bool Opaque)
+{
+	d->OpaqueResize = Opaque;
+}
+
+
+//============================================================================
+bool CDockFlatLayoutWidget::opaqueResize() const
+{
+	return d->OpaqueResize;
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::setOpaqueResizeInterval(int Milliseconds)
+{
+	d->OpaqueResizeInterval = qMax(0, Milliseconds);
+}
+
+
+//============================================================================
+int CDockFlatLayoutWidget::opaqueResizeInterval() const
+{
+	return d->OpaqueResizeInterval;
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::paintEvent(QPaintEvent* e)
+{
+	QPainter Painter(this);
+	for (int i = 0; i < d->Layout->handleCount(); ++i)
+	{
+		QStyleOption Option;
+		Option.initFrom(this);
+		Option.rect = d->Layout->handleRect(i);
+		if (!Option.rect.intersects(e->rect()))
+		{
+			continue;
+		}
+
+		Option.state = isEnabled() ? QStyle::State_Enabled : QStyle::State_None;
+		if (d->Layout->handleOrientation(i) == Qt::Horizontal)
+		{
+			Option.state |= QStyle::State_Horizontal;
+		}
+		if (i == d->HoverHandle)
+		{
+			Option.state |= QStyle::State_MouseOver;
+		}
+		if (i == d->DragHandle)
+		{
+			Option.state |= QStyle::State_Sunken;
+		}
+		style()->drawControl(QStyle::CE_Splitter, &Option, &Painter, this);
+	}
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::mousePressEvent(QMouseEvent* e)
+{
+	int Handle = (e->button() == Qt::LeftButton) ? d->Layout->handleAt(e->pos()) : -1;
+	if (Handle < 0)
+	{
+		Super::mousePressEvent(e);
+		return;
+	}
+
+	d->DragHandle = Handle;
+	d->DragOffset = e->pos() - d->Layout->handleRect(Handle).topLeft();
+	d->HasPendingPos = false;
+	d->beginHandleDrag();
+	update();
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::mouseMoveEvent(QMouseEvent* e)
+{
+	if (d->DragHandle < 0)
+	{
+		d->setHoverHandle(d->Layout->handleAt(e->pos()));
+		return;
+	}
+
+	if (!d->isDragging() || !(e->buttons() & Qt::LeftButton))
+	{
+		return;
+	}
+
+	d->PendingPos = e->pos();
+	d->HasPendingPos = true;
+	if (!d->OpaqueResize)
+	{
+		d->updateRubberBand();
+		return;
+	}
+
+	// The first move is applied immediately, all further moves within the
+	// interval are collapsed into one move when the timer expires
+	if (!d->ResizeTimer.isActive())
+	{
+		d->applyPendingPos();
+	}
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::mouseReleaseEvent(QMouseEvent* e)
+{
+	if (d->DragHandle < 0 || e->button() != Qt::LeftButton)
+	{
+		Super::mouseReleaseEvent(e);
+		return;
+	}
+
+	d->ResizeTimer.stop();
+	d->PendingPos = e->pos();
+	d->HasPendingPos = true;
+	d->applyPendingPos();
+	d->ResizeTimer.stop();
+	if (d->RubberBand)
+	{
+		d->RubberBand->hide();
+	}
+	d->DragHandle = -1;
+	d->endHandleDrag();
+	update();
+}
+
+
+//============================================================================
+void CDockFlatLayoutWidget::leaveEvent(QEvent* e)
+{
+	if (d->DragHandle < 0)
+	{
+		d->setHoverHandle(-1);
+	}
+	Super::leaveEvent(e);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockFlatLayout.cpp
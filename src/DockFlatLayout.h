@@ -0,0 +1,268 @@
+#ifndef DockFlatLayoutH
+#define DockFlatLayoutH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockFlatLayout.h
+/// \date   18.10.2026
+/// \brief  Declaration of CDockFlatLayout and CDockFlatLayoutWidget classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QLayout>
+#include <QList>
+#include <QWidget>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct DockFlatLayoutPrivate;
+struct DockFlatLayoutWidgetPrivate;
+
+/**
+ * A node of the split tree of a CDockFlatLayout.
+ * A node is either a leaf with a content widget or a split node with an
+ * orientation and a list of child nodes. The size of a node is its extent
+ * in pixels along the orientation of its parent node.
+ */
+struct CDockFlatLayoutNode
+{
+	Qt::Orientation Orientation = Qt::Horizontal; ///< orientation of a split node
+	QWidget* Widget = nullptr; ///< content widget of a leaf node
+	int Size = 0;
+	QList<CDockFlatLayoutNode> Children;
+
+	/**
+	 * Returns true, if this node is a leaf with a content widget
+	 */
+	bool isLeaf() const {return Widget != nullptr;}
+
+	/**
+	 * Returns true, if this node or any of its children contains a
+	 * content widget that is not hidden
+	 */
+	bool hasVisibleContent() const;
+}; // struct CDockFlatLayoutNode
+
+
+/**
+ * Layout that arranges the dock areas of a container from a split tree that
+ * is held as plain data.
+ * Instead of one QSplitter per split node, the whole tree is flattened and
+ * solved in one pass: the minimum, maximum and preferred sizes are computed
+ * bottom up and the available space is distributed top down. Size changes
+ * go to the nodes that contain the central widget first. The handles
+ * between the nodes are no widgets - they are painted and dragged by the
+ * CDockFlatLayoutWidget that owns the layout.
+ */
+class ADS_EXPORT CDockFlatLayout : public QLayout
+{
+	Q_OBJECT
+private:
+	DockFlatLayoutPrivate* d; ///< private data (pimpl)
+	friend struct DockFlatLayoutPrivate;
+
+public:
+	using Super = QLayout;
+
+	/**
+	 * Default Constructor
+	 */
+	CDockFlatLayout(QWidget* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockFlatLayout();
+
+	/**
+	 * Sets the width of the handles between the nodes
+	 */
+	void setHandleWidth(int Width);
+
+	/**
+	 * Returns the width of the handles between the nodes
+	 */
+	int handleWidth() const;
+
+	/**
+	 * Returns the root node of the split tree.
+	 * The root node is always a split node.
+	 */
+	const CDockFlatLayoutNode& root() const;
+
+	/**
+	 * Replaces the split tree with the given tree and adds all content
+	 * widgets of the tree to this layout
+	 */
+	void setRoot(const CDockFlatLayoutNode& Root);
+
+	/**
+	 * Removes the whole split tree from this layout and returns it.
+	 * The content widgets are not reparented - this is done when the tree
+	 * is inserted into another layout via insertTree()
+	 */
+	CDockFlatLayoutNode takeRoot();
+
+	/**
+	 * Inserts the given widget into the given area of the Target widget.
+	 * If Target is a nullptr, the widget is inserted into the given area of
+	 * the whole layout. The orientation rules are the same as for the
+	 * splitters of CDockContainerWidget.
+	 */
+	void insertWidget(QWidget* Widget, DockWidgetArea Area, QWidget* Target = nullptr);
+
+	/**
+	 * Inserts the given split tree into the given area of the Target widget.
+	 * A tree with the insertion orientation is merged into the target node.
+	 */
+	void insertTree(const CDockFlatLayoutNode& Tree, DockWidgetArea Area,
+		QWidget* Target = nullptr);
+
+	/**
+	 * Gives all visible siblings of the given widget the same size
+	 */
+	void distributeEvenly(QWidget* Widget);
+
+	/**
+	 * Returns the number of visible handles
+	 */
+	int handleCount() const;
+
+	/**
+	 * Returns the geometry of the given handle
+	 */
+	QRect handleRect(int Handle) const;
+
+	/**
+	 * Returns the orientation of the split node of the given handle
+	 */
+	Qt::Orientation handleOrientation(int Handle) const;
+
+	/**
+	 * Returns the index of the handle at the given position or -1 if there
+	 * is no handle
+	 */
+	int handleAt(const QPoint& Pos) const;
+
+	/**
+	 * Returns the visible content widgets of both nodes that are resized by
+	 * the given handle
+	 */
+	QList<QWidget*> handleWidgets(int Handle) const;
+
+	/**
+	 * Moves the given handle by the given offset in pixels.
+	 * Only the two nodes next to the handle are resized and the offset is
+	 * limited by their minimum and maximum sizes.
+	 */
+	void moveHandle(int Handle, int Offset);
+
+public: // reimplements QLayout -----------------------------------------------
+	virtual void addItem(QLayoutItem* Item) override;
+	virtual QLayoutItem* itemAt(int Index) const override;
+	virtual QLayoutItem* takeAt(int Index) override;
+	virtual int count() const override;
+	virtual QSize sizeHint() const override;
+	virtual QSize minimumSize() const override;
+	virtual QSize maximumSize() const override;
+	virtual void setGeometry(const QRect& Rect) override;
+	virtual void invalidate() override;
+}; // class CDockFlatLayout
+
+
+/**
+ * Host widget of a CDockFlatLayout.
+ * The widget paints the handles of its layout and resizes the nodes if the
+ * user drags a handle. Like CDockSplitter, it supports opaque and non opaque
+ * resizing with an optional minimum interval between two live updates and it
+ * reports handle drags as interactions to the dock manager.
+ */
+class ADS_EXPORT CDockFlatLayoutWidget : public QWidget
+{
+	Q_OBJECT
+private:
+	DockFlatLayoutWidgetPrivate* d; ///< private data (pimpl)
+	friend struct DockFlatLayoutWidgetPrivate;
+
+protected:
+	virtual void paintEvent(QPaintEvent* e) override;
+	virtual void mousePressEvent(QMouseEvent* e) override;
+	virtual void mouseMoveEvent(QMouseEvent* e) override;
+	virtual void mouseReleaseEvent(QMouseEvent* e) override;
+	virtual void leaveEvent(QEvent* e) override;
+
+public:
+	using Super = QWidget;
+
+	/**
+	 * Default Constructor
+	 */
+	CDockFlatLayoutWidget(QWidget* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CDockFlatLayoutWidget();
+
+	/**
+	 * Returns the layout of this widget
+	 */
+	CDockFlatLayout* flatLayout() const;
+
+	/**
+	 * If opaque resize is enabled, the nodes are resized while a handle is
+	 * dragged. Otherwise a rubber band shows the new position and the nodes
+	 * are resized on release.
+	 */
+	void setOpaqueResize(bool Opaque);
+
+	/**
+	 * Returns true if opaque resize is enabled
+	 */
+	bool opaqueResize() const;
+
+	/**
+	 * Sets the minimum interval in milliseconds between two live updates of
+	 * an opaque handle drag.
+	 * \see CDockSplitter::setOpaqueResizeInterval()
+	 */
+	void setOpaqueResizeInterval(int Milliseconds);
+
+	/**
+	 * Returns the minimum interval between two live updates
+	 */
+	int opaqueResizeInterval() const;
+
+signals:
+	/**
+	 * This signal is emitted each time a handle drag has changed the sizes
+	 * of the nodes
+	 */
+	void handleMoved();
+}; // class CDockFlatLayoutWidget
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // DockFlatLayoutH
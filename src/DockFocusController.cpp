@@ -16,6 +16,7 @@
 #include <QPointer>
 #include <QApplication>
 #include <QAbstractButton>
+#include <QHash>
 
 #include "DockWidget.h"
 #include "DockAreaWidget.h"
@@ -24,6 +25,7 @@
 #include "FloatingDockContainer.h"
 #include "DockManager.h"
 #include "DockAreaTitleBar.h"
+#include "RepolishScheduler.h"
 
 #ifdef Q_OS_LINUX
 #include "linux/FloatingWidgetTitleBar.h"
@@ -31,6 +33,21 @@
 
 namespace ads
 {
+/**
+ * Upper limit for the number of cached focus widgets. If the limit is
+ * reached, the cache is cleared and filled again from the focus changes
+ */
+static const int MaxOwnerCacheSize = 1024;
+
+/**
+ * Cached owning dock widget of a focus widget
+ */
+struct FocusOwnerEntry
+{
+	QPointer<CDockWidget> DockWidget;
+	bool HasDockWidget = false;
+};
+
 /**
  * Private data class of CDockFocusController class (pimpl)
  */
@@ -45,6 +62,8 @@ struct DockFocusControllerPrivate
 #endif
 	CDockManager* DockManager;
     bool ForceFocusChangedSignal = false;
+    bool FocusStyleOutdated = false;
+	QHash<QWidget*, FocusOwnerEntry> OwnerCache;
 
 	/**
 	 * Private data constructor
@@ -53,9 +72,28 @@ struct DockFocusControllerPrivate
 
 	/**
 	 * This function updates the focus style of the given dock widget and
-	 * the dock area that it belongs to
+	 * the dock area that it belongs to. All repolish requests are merged
+	 * into one flush of the repolish scheduler
 	 */
 	void updateDockWidgetFocus(CDockWidget* DockWidget);
+
+	/**
+	 * Implementation of updateDockWidgetFocus()
+	 */
+	void applyDockWidgetFocus(CDockWidget* DockWidget);
+
+	/**
+	 * Returns the dock widget that contains the given widget.
+	 * The result is cached until the widget is reparented or destroyed or
+	 * until the content of a dock widget changes, so repeated focus changes
+	 * inside the same widgets do not search the parent chain again
+	 */
+	CDockWidget* owningDockWidget(QWidget* Widget);
+
+	/**
+	 * Removes the given widget from the owner cache
+	 */
+	void removeOwnerCacheEntry(QWidget* Widget);
 };
 // struct DockFocusControllerPrivate
 
@@ -107,6 +145,62 @@ DockFocusControllerPrivate::DockFocusControllerPrivate(
 }
 
 
+//============================================================================
+CDockWidget* DockFocusControllerPrivate::owningDockWidget(QWidget* Widget)
+{
+	// If an ancestor of the widget has been moved into another dock widget,
+	// then the cached dock widget is no ancestor anymore. This check only
+	// walks up to the cached dock widget
+	auto it = OwnerCache.constFind(Widget);
+	if (it != OwnerCache.constEnd() && (!it->HasDockWidget
+		|| (it->DockWidget && it->DockWidget->isAncestorOf(Widget))))
+	{
+		return it->DockWidget.data();
+	}
+
+	auto DockWidget = qobject_cast<CDockWidget*>(Widget);
+	if (!DockWidget)
+	{
+		DockWidget = internal::findParent<CDockWidget*>(Widget);
+	}
+
+	if (OwnerCache.count() >= MaxOwnerCacheSize)
+	{
+		for (auto CachedWidget : OwnerCache.keys())
+		{
+			removeOwnerCacheEntry(CachedWidget);
+		}
+	}
+
+	if (!OwnerCache.contains(Widget))
+	{
+		Widget->installEventFilter(_this);
+		QObject::connect(Widget, &QObject::destroyed, _this, [this, Widget]()
+		{
+			OwnerCache.remove(Widget);
+		});
+	}
+	FocusOwnerEntry Entry;
+	Entry.DockWidget = DockWidget;
+	Entry.HasDockWidget = (DockWidget != nullptr);
+	OwnerCache.insert(Widget, Entry);
+	return DockWidget;
+}
+
+
+//============================================================================
+void DockFocusControllerPrivate::removeOwnerCacheEntry(QWidget* Widget)
+{
+	if (!OwnerCache.remove(Widget))
+	{
+		return;
+	}
+
+	Widget->removeEventFilter(_this);
+	QObject::disconnect(Widget, &QObject::destroyed, _this, nullptr);
+}
+
+
 //============================================================================
 void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
 {
@@ -115,6 +209,26 @@ void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
 		return;
 	}
 
+	// Fast path - the focus moved inside of the focused dock widget, so the
+	// focus style is still valid and no signal needs to be emitted
+	if (DockWidget == FocusedDockWidget && !ForceFocusChangedSignal
+	 && !FocusStyleOutdated && FocusedArea == DockWidget->dockAreaWidget())
+	{
+		return;
+	}
+
+	auto RepolishScheduler = CRepolishScheduler::instance();
+	RepolishScheduler->hold();
+	applyDockWidgetFocus(DockWidget);
+	RepolishScheduler->release();
+}
+
+
+//============================================================================
+void DockFocusControllerPrivate::applyDockWidgetFocus(CDockWidget* DockWidget)
+{
+	FocusStyleOutdated = false;
+
 	CDockAreaWidget* NewFocusedDockArea = nullptr;
 	if (FocusedDockWidget)
 	{
@@ -142,7 +256,7 @@ void DockFocusControllerPrivate::updateDockWidgetFocus(CDockWidget* DockWidget)
     auto NewFloatingWidget = FocusedDockWidget->dockContainer()->floatingWidget();
     if (NewFloatingWidget)
     {
-    	NewFloatingWidget->setProperty("FocusedDockWidget", QVariant::fromValue(DockWidget));
+    	NewFloatingWidget->setFocusedDockWidget(DockWidget);
     }
 
 
@@ -264,7 +378,7 @@ void CDockFocusController::onApplicationFocusChanged(QWidget* focusedOld, QWidge
         // focused widget focusedOld
         if (focusedOld)
         {
-            auto OldFocusedDockWidget = internal::findParent<CDockWidget*>(focusedOld);
+            auto OldFocusedDockWidget = d->owningDockWidget(focusedOld);
             if (OldFocusedDockWidget && OldFocusedDockWidget == DockWidget)
             {
                 focusedOld->setFocus();
@@ -274,12 +388,7 @@ void CDockFocusController::onApplicationFocusChanged(QWidget* focusedOld, QWidge
 
 	if (!DockWidget)
 	{
-		DockWidget = qobject_cast<CDockWidget*>(focusedNow);
-	}
-
-	if (!DockWidget)
-	{
-		DockWidget = internal::findParent<CDockWidget*>(focusedNow);
+		DockWidget = d->owningDockWidget(focusedNow);
 	}
 
 #ifdef Q_OS_LINUX
@@ -365,13 +474,7 @@ void CDockFocusController::notifyFloatingWidgetDrop(CFloatingDockContainer* Floa
 		return;
 	}
 
-	auto vDockWidget = FloatingWidget->property("FocusedDockWidget");
-	if (!vDockWidget.isValid())
-	{
-		return;
-	}
-
-	auto DockWidget = vDockWidget.value<CDockWidget*>();
+	auto DockWidget = FloatingWidget->focusedDockWidget();
 	if (DockWidget)
 	{
 		d->FocusedDockWidget = nullptr;
@@ -387,7 +490,30 @@ void CDockFocusController::onStateRestored()
 	if (d->FocusedDockWidget)
 	{
 		updateDockWidgetFocusStyle(d->FocusedDockWidget, false);
+		d->FocusStyleOutdated = true;
+	}
+}
+
+
+//==========================================================================
+void CDockFocusController::invalidateOwnerCache()
+{
+	for (auto Widget : d->OwnerCache.keys())
+	{
+		d->removeOwnerCacheEntry(Widget);
+	}
+}
+
+
+//==========================================================================
+bool CDockFocusController::eventFilter(QObject* watched, QEvent* event)
+{
+	// A reparented widget may belong to another dock widget now
+	if (event->type() == QEvent::ParentChange)
+	{
+		d->removeOwnerCacheEntry(static_cast<QWidget*>(watched));
 	}
+	return Super::eventFilter(watched, event);
 }
 
 
@@ -36,6 +36,12 @@ private slots:
 	void onStateRestored();
 	void onDockWidgetVisibilityChanged(bool Visible);
 
+protected:
+	/**
+	 * Invalidates the cached owning dock widget of reparented focus widgets
+	 */
+	virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
 public:
 	using Super = QObject;
 	/**
@@ -83,6 +89,14 @@ public:
 	 */
 	CDockWidget* focusedDockWidget() const;
 
+	/**
+	 * Clears the cache that maps focus widgets to their owning dock widget.
+	 * Must be called if widgets are moved between dock widgets without
+	 * reparenting the focus widget itself, i.e. if the content widget of a
+	 * dock widget is replaced
+	 */
+	void invalidateOwnerCache();
+
 public slots:
 	/**
 	 * Request a focus change to the given dock widget
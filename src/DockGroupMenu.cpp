@@ -1,11 +1,36 @@
 #include "DockGroupMenu.h"
 
+#include <memory>
+#include <vector>
+
+#include <QHash>
 #include <QMenu>
+#include <QPointer>
 
+#include "DockAreaWidget.h"
 #include "DockManager.h"
 #include "DockWidget.h"
 
 namespace ads {
+/**
+ * A group of the group menu
+ */
+struct DockGroupEntry
+{
+    QString Name;
+    QVector<CDockWidget *> Widgets;
+    QMenu *SubMenu = nullptr;
+};
+
+/**
+ * Index entry of a widget in the group menu
+ */
+struct DockGroupWidgetEntry
+{
+    QAction *Action = nullptr;
+    DockGroupEntry *Group = nullptr;
+};
+
 struct DockGroupMenuPrivate
 {
 /**
@@ -14,6 +39,12 @@ struct DockGroupMenuPrivate
     CDockGroupMenu*	_this			= nullptr;
     CDockManager*	DockManager	    = nullptr;
     CDockGroupMenu::GroupFlag GroupMethod = CDockGroupMenu::GroupToSubmenu;
+    std::vector<std::unique_ptr<DockGroupEntry>> Groups;
+    QHash<QString, DockGroupEntry *> GroupsByName;
+    QHash<CDockWidget *, DockGroupWidgetEntry> Widgets;
+    QMenu *Menu = nullptr;
+    bool MenuOutdated = true;
+    QPointer<CDockAreaWidget> TargetArea;
 
     /**
      * Private data constructor
@@ -24,61 +55,64 @@ struct DockGroupMenuPrivate
         DockManager = manager;
     }
 
-    void fillMenu(QMenu *menu,
-                  const std::vector<QString> &list,
-                  const std::map<QString, QAction *> &actions)
+    /**
+     * Returns true, if the actions of the given group are shown in a
+     * sub menu
+     */
+    bool hasSubMenu(const DockGroupEntry *group) const
     {
-        for (const auto &name : list) {
-            auto action_it = actions.find(name);
-            if (action_it != actions.end()) {
-                menu->addAction(action_it->second);
-            }
+        return !group->Name.isEmpty() && CDockGroupMenu::GroupToSubmenu == GroupMethod;
+    }
+
+    /**
+     * Inserts or activates the given widget in the current target area
+     */
+    void onActionTriggered(CDockWidget *widget)
+    {
+        auto area = TargetArea.data();
+        if (area && widget->dockAreaWidget() != area) {
+            DockManager->addDockWidgetTabToArea(widget, area);
         }
+        widget->toggleView(true);
     }
 
-    QMenu *createMenu(const std::map<QString, std::map<QString, QAction *>> &groupedActions)
+    /**
+     * Refills the root menu from the groups. The actions are reused, only
+     * the separators are created again
+     */
+    void rebuildMenu()
     {
-        QMenu *resMenu = new QMenu();
-        for (const auto &ga : List) {
-            const auto &groupName = ga.first;
-            const auto &actionList = ga.second;
-            auto groupA_it = groupedActions.find(groupName);
-            if (groupA_it == groupedActions.end()) {
+        MenuOutdated = false;
+        Menu->clear();
+        for (const auto &group : Groups) {
+            if (group->Widgets.isEmpty()) {
                 continue;
             }
-            const auto &actionMap = groupA_it->second;
-            if (groupName.isEmpty()) {
-                //add as root action
-                for (const auto &name : actionList) {
-                    auto action_it = actionMap.find(name);
-                    if (action_it != actionMap.end()) {
-                        resMenu->addAction(action_it->second);
-                    }
-                }
-            } else {
-                switch (GroupMethod) {
-                case CDockGroupMenu::GroupToSubmenu:{
-                    QAction *subaction = new QAction(groupName);
-                    auto submenu = new QMenu();
-                    subaction->setMenu(submenu);
-                    fillMenu(submenu, actionList, actionMap);
-                    resMenu->addAction(subaction);
-                }break;
-                case CDockGroupMenu::GroupToRoot:
-                    fillMenu(resMenu, actionList, actionMap);
-                    if (!actionList.empty()) {
-                        resMenu->addSeparator();
-                    }
-                    break;
-                default:
-                    break;
-                }
+
+            if (hasSubMenu(group.get())) {
+                Menu->addMenu(group->SubMenu);
+                continue;
+            }
+
+            for (auto widget : group->Widgets) {
+                Menu->addAction(Widgets.value(widget).Action);
+            }
+            if (!group->Name.isEmpty()) {
+                Menu->addSeparator();
             }
         }
-        return resMenu;
     }
 
-    std::vector<std::pair<QString, std::vector<QString>>> List;
+    /**
+     * Returns the sub menu of the given group and creates it if required
+     */
+    QMenu *subMenu(DockGroupEntry *group)
+    {
+        if (!group->SubMenu) {
+            group->SubMenu = new QMenu(group->Name);
+        }
+        return group->SubMenu;
+    }
 };
 
 
@@ -88,92 +122,147 @@ CDockGroupMenu::CDockGroupMenu(CDockManager *manager)
 
 }
 
+CDockGroupMenu::~CDockGroupMenu()
+{
+    for (const auto &group : d->Groups) {
+        delete group->SubMenu;
+    }
+    delete d->Menu;
+    delete d;
+}
+
 void CDockGroupMenu::addGroup(const QString &name, int index)
 {
-    if (index > -1 && d->List.size() > index) {
-        d->List.insert(d->List.begin() + index, {name, {}});
+    std::unique_ptr<DockGroupEntry> group(new DockGroupEntry);
+    group->Name = name;
+    if (!d->GroupsByName.contains(name)) {
+        d->GroupsByName.insert(name, group.get());
+    }
+    if (index > -1 && int(d->Groups.size()) > index) {
+        d->Groups.insert(d->Groups.begin() + index, std::move(group));
     } else {
-        d->List.push_back({name, {}});
+        d->Groups.push_back(std::move(group));
     }
+    d->MenuOutdated = true;
 }
 
 void CDockGroupMenu::addWidget(const QString &groupName, CDockWidget *widget, int index)
 {
-    for (auto &g : d->List) {
-        auto &actionList = g.second;
-        auto &group = g.first;
-        if (group == groupName) {
-            if (index > -1 && actionList.size() > index) {
-                actionList.insert(actionList.begin() + index, widget->windowTitle());
-            } else {
-                actionList.push_back(widget->windowTitle());
-            }
-            break;
+    auto group = d->GroupsByName.value(groupName, nullptr);
+    if (!group || !widget) {
+        return;
+    }
+
+    removeWidget(widget);
+    if (index < 0 || index > group->Widgets.count()) {
+        index = group->Widgets.count();
+    }
+
+    DockGroupWidgetEntry entry;
+    entry.Group = group;
+    entry.Action = new QAction(widget->windowTitle(), this);
+    QPointer<CDockWidget> widgetPointer(widget);
+    connect(entry.Action, &QAction::triggered, this, [=]() {
+        if (widgetPointer) {
+            d->onActionTriggered(widgetPointer);
         }
+    });
+    connect(widget, &QObject::destroyed, entry.Action, [=]() {
+        removeWidget(widget);
+    });
+    d->Widgets.insert(widget, entry);
+
+    if (d->hasSubMenu(group)) {
+        auto before = (index < group->Widgets.count())
+            ? d->Widgets.value(group->Widgets.at(index)).Action : nullptr;
+        d->subMenu(group)->insertAction(before, entry.Action);
+    }
+    group->Widgets.insert(index, widget);
+    // The root menu only changes if a sub menu becomes visible or if the
+    // action is placed in the root menu
+    if (!d->hasSubMenu(group) || group->Widgets.count() == 1) {
+        d->MenuOutdated = true;
     }
 }
 
 void CDockGroupMenu::removeWidget(CDockWidget *widget)
 {
-    for (auto &g : d->List) {
-        auto &actionList = g.second;
-        const auto &actionName = widget->windowTitle();
-        for (auto it = actionList.begin(); it != actionList.end(); ++it) {
-            if (*it == actionName) {
-                actionList.erase(it);
-                return;
-            }
-        }
+    auto it = d->Widgets.find(widget);
+    if (it == d->Widgets.end()) {
+        return;
+    }
+
+    auto entry = it.value();
+    d->Widgets.erase(it);
+    entry.Group->Widgets.removeOne(widget);
+    if (d->hasSubMenu(entry.Group)) {
+        entry.Group->SubMenu->removeAction(entry.Action);
     }
+    if (!d->hasSubMenu(entry.Group) || entry.Group->Widgets.isEmpty()) {
+        d->MenuOutdated = true;
+    }
+    // the action is removed from the root menu by its destructor
+    delete entry.Action;
 }
 
 void CDockGroupMenu::renameAction(const QString &groupName, const QString &oldName, const QString &newName)
 {
-    for (auto &ga : d->List) {
-        if (ga.first == groupName) {
-            auto &list = ga.second;
-            for (size_t i = 0; i < list.size(); ++i) {
-                if (list[i] == oldName) {
-                    list[i] = newName;
-                    return;
-                }
-            }
+    auto group = d->GroupsByName.value(groupName, nullptr);
+    if (!group) {
+        return;
+    }
+
+    for (auto widget : group->Widgets) {
+        auto action = d->Widgets.value(widget).Action;
+        if (action->text() == oldName) {
+            action->setText(newName);
+            return;
         }
     }
 }
 
-QMenu *CDockGroupMenu::getMenu(CDockAreaWidget *area)
+void CDockGroupMenu::updateWidget(CDockWidget *widget)
 {
-    if (!d->DockManager) {
-        return {};
-    }
-
-    std::map<QString, std::map<QString, QAction *>> groupActions;
-
-    const auto &widgetsList = d->DockManager->dockWidgetsMap();
-    // adding all widgets
-    // if widget tabbed - opening it
-    for (const auto &w : widgetsList) {
-        QAction *action = nullptr;
-        if (w->dockAreaWidget() == area) {
-            action = new QAction(w->windowTitle());
-            connect(action, &QAction::triggered, this, [=]() { w->toggleView(true); });
-        } else {
-            action = new QAction(w->windowTitle());
-            connect(action, &QAction::triggered, this, [=]() {
-                d->DockManager->addDockWidgetTabToArea(w, area);
-                w->toggleView(true);
-            });
-        }
-        const auto groupName = w->getGroupName();
-        groupActions[groupName].insert({action->text(), action});
+    auto action = d->Widgets.value(widget).Action;
+    if (action) {
+        action->setText(widget->windowTitle());
     }
-    return d->createMenu(groupActions);
+}
+
+QMenu *CDockGroupMenu::menu()
+{
+    if (!d->Menu) {
+        d->Menu = new QMenu();
+        // The menu is refilled lazily when it is shown
+        connect(d->Menu, &QMenu::aboutToShow, this, [=]() {
+            if (d->MenuOutdated) {
+                d->rebuildMenu();
+            }
+        });
+    }
+    return d->Menu;
+}
+
+void CDockGroupMenu::setTargetArea(CDockAreaWidget *area)
+{
+    d->TargetArea = area;
+}
+
+CDockAreaWidget *CDockGroupMenu::targetArea() const
+{
+    return d->TargetArea.data();
+}
+
+QMenu *CDockGroupMenu::getMenu(CDockAreaWidget *area)
+{
+    setTargetArea(area);
+    return menu();
 }
 
 void CDockGroupMenu::setGroupMethod(CDockGroupMenu::GroupFlag method)
 {
     d->GroupMethod = method;
+    d->MenuOutdated = true;
 }
 
 }
@@ -15,6 +15,12 @@ class CDockManager;
  * Group menu used for adding widget as tab to already existed tabs
  * If widget already in requested tab are it doesn't showed in menu
  * If widget already in requested tab but closed it showes in menu but action will just toggle it visibility
+ *
+ * The group menu is a persistent model that is indexed by dock widget.
+ * Each dock widget has exactly one action that is created when the widget
+ * is added and reused by all dock areas. All dock areas share one menu -
+ * the dock area that opens the menu sets itself as target area, so the
+ * action decides at trigger time where the dock widget is inserted.
  */
 
 class CDockGroupMenu : public QObject
@@ -29,6 +35,11 @@ public:
 
     explicit CDockGroupMenu(CDockManager *manager);
 
+    /**
+     * Virtual Destructor
+     */
+    virtual ~CDockGroupMenu();
+
     /**
      * Insert sub menu with given name to group menu by given index
      * if index is out of range appends to end
@@ -52,7 +63,30 @@ public:
     void renameAction(const QString &groupName, const QString &oldName, const QString &newName);
 
     /**
-     * Create action of group menu accoding to given area
+     * Updates the action text of the given widget from its window title
+     */
+    void updateWidget(CDockWidget *widget);
+
+    /**
+     * Returns the persistent menu that is shared by all dock areas.
+     * The menu is owned by the group menu
+     */
+    QMenu *menu();
+
+    /**
+     * Sets the dock area the triggered actions insert their widgets into.
+     * A dock area calls this function before it shows the menu
+     */
+    void setTargetArea(CDockAreaWidget *area);
+
+    /**
+     * Returns the current target area
+     */
+    CDockAreaWidget *targetArea() const;
+
+    /**
+     * Returns the shared menu with the given area as target area.
+     * The menu is owned by the group menu
      */
     QMenu *getMenu(CDockAreaWidget *area);
 
@@ -64,8 +98,7 @@ public:
 
 private:
     DockGroupMenuPrivate *d = nullptr;
-
-
+    friend struct DockGroupMenuPrivate;
 };
 }
 
@@ -0,0 +1,284 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockLayout.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CDockLayoutNode and CDockLayout classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockLayout.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+
+namespace ads
+{
+static const QLatin1String OrientationKey("orientation");
+static const QLatin1String ChildrenKey("children");
+static const QLatin1String DockWidgetsKey("dockWidgets");
+static const QLatin1String CurrentKey("current");
+static const QLatin1String SizeKey("size");
+static const QLatin1String RootKey("root");
+static const QLatin1String FloatingKey("floating");
+static const QLatin1String GeometryKey("geometry");
+
+
+//============================================================================
+static void setOk(bool* Ok, bool Value)
+{
+	if (Ok)
+	{
+		*Ok = Value;
+	}
+}
+
+
+//============================================================================
+CDockLayoutNode CDockLayoutNode::splitter(Qt::Orientation Orientation,
+	const QList<CDockLayoutNode>& Children)
+{
+	CDockLayoutNode Node;
+	Node.m_Type = SplitterNode;
+	Node.m_Orientation = Orientation;
+	Node.m_Children = Children;
+	return Node;
+}
+
+
+//============================================================================
+CDockLayoutNode CDockLayoutNode::area(const QStringList& DockWidgets,
+	const QString& CurrentDockWidget)
+{
+	CDockLayoutNode Node;
+	Node.m_Type = AreaNode;
+	Node.m_DockWidgets = DockWidgets;
+	Node.m_CurrentDockWidget = CurrentDockWidget;
+	return Node;
+}
+
+
+//============================================================================
+CDockLayoutNode& CDockLayoutNode::setSize(qreal Size)
+{
+	m_Size = Size;
+	return *this;
+}
+
+
+//============================================================================
+CDockLayoutNode& CDockLayoutNode::addChild(const CDockLayoutNode& Child)
+{
+	m_Children.append(Child);
+	return *this;
+}
+
+
+//============================================================================
+QJsonObject CDockLayoutNode::toJson() const
+{
+	QJsonObject Json;
+	if (AreaNode == m_Type)
+	{
+		Json.insert(DockWidgetsKey, QJsonArray::fromStringList(m_DockWidgets));
+		if (!m_CurrentDockWidget.isEmpty())
+		{
+			Json.insert(CurrentKey, m_CurrentDockWidget);
+		}
+	}
+	else
+	{
+		Json.insert(OrientationKey, (Qt::Horizontal == m_Orientation)
+			? QStringLiteral("horizontal") : QStringLiteral("vertical"));
+		QJsonArray Children;
+		for (const auto& Child : m_Children)
+		{
+			Children.append(Child.toJson());
+		}
+		Json.insert(ChildrenKey, Children);
+	}
+	Json.insert(SizeKey, m_Size);
+	return Json;
+}
+
+
+//============================================================================
+CDockLayoutNode CDockLayoutNode::fromJson(const QJsonObject& Json, bool* Ok)
+{
+	setOk(Ok, true);
+	CDockLayoutNode Node;
+	if (Json.contains(SizeKey))
+	{
+		Node.m_Size = Json.value(SizeKey).toDouble(1.0);
+		if (Node.m_Size <= 0)
+		{
+			setOk(Ok, false);
+			return Node;
+		}
+	}
+
+	if (Json.contains(DockWidgetsKey))
+	{
+		Node.m_Type = AreaNode;
+		for (const auto& Value : Json.value(DockWidgetsKey).toArray())
+		{
+			Node.m_DockWidgets.append(Value.toString());
+		}
+		Node.m_CurrentDockWidget = Json.value(CurrentKey).toString();
+		return Node;
+	}
+
+	auto Orientation = Json.value(OrientationKey).toString(QStringLiteral("horizontal"));
+	if (Orientation == QLatin1String("horizontal"))
+	{
+		Node.m_Orientation = Qt::Horizontal;
+	}
+	else if (Orientation == QLatin1String("vertical"))
+	{
+		Node.m_Orientation = Qt::Vertical;
+	}
+	else
+	{
+		setOk(Ok, false);
+		return Node;
+	}
+
+	for (const auto& Value : Json.value(ChildrenKey).toArray())
+	{
+		bool ChildOk;
+		Node.m_Children.append(fromJson(Value.toObject(), &ChildOk));
+		if (!ChildOk)
+		{
+			setOk(Ok, false);
+			return Node;
+		}
+	}
+	return Node;
+}
+
+
+//============================================================================
+CDockLayout::CDockLayout(const CDockLayoutNode& Root) :
+	m_Root(Root)
+{
+
+}
+
+
+//============================================================================
+CDockLayout& CDockLayout::setRoot(const CDockLayoutNode& Root)
+{
+	m_Root = Root;
+	return *this;
+}
+
+
+//============================================================================
+CDockLayout& CDockLayout::addFloatingWindow(const CDockLayoutNode& Root,
+	const QRect& Geometry)
+{
+	m_FloatingWindows.append({Root, Geometry});
+	return *this;
+}
+
+
+//============================================================================
+QJsonObject CDockLayout::toJson() const
+{
+	QJsonObject Json;
+	Json.insert(RootKey, m_Root.toJson());
+	if (m_FloatingWindows.isEmpty())
+	{
+		return Json;
+	}
+
+	QJsonArray FloatingWindows;
+	for (const auto& FloatingWindow : m_FloatingWindows)
+	{
+		QJsonObject Window;
+		Window.insert(RootKey, FloatingWindow.Root.toJson());
+		if (FloatingWindow.Geometry.isValid())
+		{
+			const auto& r = FloatingWindow.Geometry;
+			Window.insert(GeometryKey, QJsonArray({r.x(), r.y(), r.width(), r.height()}));
+		}
+		FloatingWindows.append(Window);
+	}
+	Json.insert(FloatingKey, FloatingWindows);
+	return Json;
+}
+
+
+//============================================================================
+CDockLayout CDockLayout::fromJson(const QJsonObject& Json, bool* Ok)
+{
+	bool NodeOk;
+	CDockLayout Layout(CDockLayoutNode::fromJson(Json.value(RootKey).toObject(), &NodeOk));
+	if (!NodeOk)
+	{
+		setOk(Ok, false);
+		return Layout;
+	}
+
+	for (const auto& Value : Json.value(FloatingKey).toArray())
+	{
+		auto Window = Value.toObject();
+		auto Root = CDockLayoutNode::fromJson(Window.value(RootKey).toObject(), &NodeOk);
+		if (!NodeOk)
+		{
+			setOk(Ok, false);
+			return Layout;
+		}
+
+		QRect Geometry;
+		auto GeometryArray = Window.value(GeometryKey).toArray();
+		if (GeometryArray.count() == 4)
+		{
+			Geometry = QRect(GeometryArray.at(0).toInt(), GeometryArray.at(1).toInt(),
+				GeometryArray.at(2).toInt(), GeometryArray.at(3).toInt());
+		}
+		Layout.addFloatingWindow(Root, Geometry);
+	}
+
+	setOk(Ok, true);
+	return Layout;
+}
+
+
+//============================================================================
+CDockLayout CDockLayout::fromJson(const QByteArray& Json, bool* Ok)
+{
+	QJsonParseError Error;
+	auto Document = QJsonDocument::fromJson(Json, &Error);
+	if (Error.error != QJsonParseError::NoError || !Document.isObject())
+	{
+		setOk(Ok, false);
+		return CDockLayout();
+	}
+
+	return fromJson(Document.object(), Ok);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockLayout.cpp
@@ -0,0 +1,203 @@
+#ifndef DockLayoutH
+#define DockLayoutH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockLayout.h
+/// \date   18.10.2026
+/// \brief  Declaration of CDockLayoutNode and CDockLayout classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QJsonObject>
+#include <QList>
+#include <QRect>
+#include <QStringList>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+/**
+ * A node of a declarative dock layout description.
+ * A node is either a splitter node with an orientation and a list of child
+ * nodes or a dock area node with a list of dock widget object names that
+ * are shown as tabs. Each node has a proportional size that defines its
+ * share of the parent splitter.
+ * \code
+ * auto Root = CDockLayoutNode::splitter(Qt::Horizontal, {
+ *     CDockLayoutNode::area({"Files", "Outline"}).setSize(1),
+ *     CDockLayoutNode::splitter(Qt::Vertical, {
+ *         CDockLayoutNode::area({"Editor"}).setSize(3),
+ *         CDockLayoutNode::area({"Log", "Terminal"}, "Log")
+ *     }).setSize(4)
+ * });
+ * \endcode
+ */
+class ADS_EXPORT CDockLayoutNode
+{
+public:
+	enum eType
+	{
+		SplitterNode,
+		AreaNode
+	};
+
+	/**
+	 * Creates an empty horizontal splitter node
+	 */
+	CDockLayoutNode() = default;
+
+	/**
+	 * Creates a splitter node with the given orientation and children
+	 */
+	static CDockLayoutNode splitter(Qt::Orientation Orientation,
+		const QList<CDockLayoutNode>& Children = QList<CDockLayoutNode>());
+
+	/**
+	 * Creates a dock area node with the given dock widgets as tabs.
+	 * If CurrentDockWidget is empty, the first dock widget is the current
+	 * one
+	 */
+	static CDockLayoutNode area(const QStringList& DockWidgets,
+		const QString& CurrentDockWidget = QString());
+
+	/**
+	 * Sets the proportional size of this node in its parent splitter.
+	 * The default size is 1
+	 */
+	CDockLayoutNode& setSize(qreal Size);
+
+	/**
+	 * Appends a child node to this splitter node
+	 */
+	CDockLayoutNode& addChild(const CDockLayoutNode& Child);
+
+	eType type() const {return m_Type;}
+	Qt::Orientation orientation() const {return m_Orientation;}
+	const QList<CDockLayoutNode>& children() const {return m_Children;}
+	const QStringList& dockWidgets() const {return m_DockWidgets;}
+	const QString& currentDockWidget() const {return m_CurrentDockWidget;}
+	qreal size() const {return m_Size;}
+
+	/**
+	 * Returns the JSON representation of this node
+	 */
+	QJsonObject toJson() const;
+
+	/**
+	 * Creates a node from the given JSON object.
+	 * If Ok is given, it is set to false if the object is not a valid node
+	 */
+	static CDockLayoutNode fromJson(const QJsonObject& Json, bool* Ok = nullptr);
+
+private:
+	eType m_Type = SplitterNode;
+	Qt::Orientation m_Orientation = Qt::Horizontal;
+	QList<CDockLayoutNode> m_Children;
+	QStringList m_DockWidgets;
+	QString m_CurrentDockWidget;
+	qreal m_Size = 1.0;
+}; // class CDockLayoutNode
+
+
+/**
+ * Declarative description of a complete dock manager layout.
+ * The layout consists of the splitter tree of the dock manager and of an
+ * optional list of floating windows. Use CDockManager::buildLayout() to
+ * construct the layout in one pass.
+ * The JSON form of the layout looks like this:
+ * \code
+ * {
+ *     "root": {"orientation": "horizontal", "children": [
+ *         {"dockWidgets": ["Files", "Outline"], "size": 1},
+ *         {"dockWidgets": ["Editor"], "current": "Editor", "size": 4}
+ *     ]},
+ *     "floating": [
+ *         {"geometry": [100, 100, 400, 300], "root": {"dockWidgets": ["Log"]}}
+ *     ]
+ * }
+ * \endcode
+ */
+class ADS_EXPORT CDockLayout
+{
+public:
+	/**
+	 * Description of a floating window
+	 */
+	struct FloatingWindow
+	{
+		CDockLayoutNode Root;
+		QRect Geometry; ///< invalid geometry keeps the default geometry
+	};
+
+	/**
+	 * Creates a layout with the given root node
+	 */
+	CDockLayout(const CDockLayoutNode& Root = CDockLayoutNode());
+
+	/**
+	 * Sets the root node of the dock manager
+	 */
+	CDockLayout& setRoot(const CDockLayoutNode& Root);
+
+	/**
+	 * Returns the root node of the dock manager
+	 */
+	const CDockLayoutNode& root() const {return m_Root;}
+
+	/**
+	 * Adds a floating window with the given root node
+	 */
+	CDockLayout& addFloatingWindow(const CDockLayoutNode& Root,
+		const QRect& Geometry = QRect());
+
+	/**
+	 * Returns the list of floating windows
+	 */
+	const QList<FloatingWindow>& floatingWindows() const {return m_FloatingWindows;}
+
+	/**
+	 * Returns the JSON representation of this layout
+	 */
+	QJsonObject toJson() const;
+
+	/**
+	 * Creates a layout from the given JSON object.
+	 * If Ok is given, it is set to false if the object is not a valid layout
+	 */
+	static CDockLayout fromJson(const QJsonObject& Json, bool* Ok = nullptr);
+
+	/**
+	 * Creates a layout from the given JSON document data
+	 */
+	static CDockLayout fromJson(const QByteArray& Json, bool* Ok = nullptr);
+
+private:
+	CDockLayoutNode m_Root;
+	QList<FloatingWindow> m_FloatingWindows;
+}; // class CDockLayout
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // DockLayoutH
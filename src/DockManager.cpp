@@ -44,7 +44,14 @@
 #include <QXmlStreamWriter>
 #include <QSettings>
 #include <QMenu>
+#include <QActionEvent>
 #include <QApplication>
+#include <QHash>
+#include <QPointer>
+#include <QSplitter>
+#include <QTimer>
+#include <QCache>
+#include <QPixmap>
 
 #include "FloatingDockContainer.h"
 #include "DockOverlay.h"
@@ -54,8 +61,11 @@
 #include "IconProvider.h"
 #include "DockingStateReader.h"
 #include "DockGroupMenu.h"
+#include "DockLayout.h"
 #include "DockAreaTitleBar.h"
 #include "DockFocusController.h"
+#include "RepolishScheduler.h"
+#include "ViewMenuPopup.h"
 
 #ifdef Q_OS_LINUX
 #include "linux/FloatingWidgetTitleBar.h"
@@ -95,7 +105,181 @@ enum eStateFileVersion
 	CurrentVersion = Version1//!< CurrentVersion
 };
 
+/**
+ * Cached content snapshot of a dock widget.
+ * The guarded pointer detects a new widget that has been created at the
+ * address of a deleted widget
+ */
+struct ContentSnapshot
+{
+	QPointer<QWidget> Widget;
+	QPixmap Pixmap;
+};
+
+static const int DefaultContentSnapshotCacheSize = 64 * 1024;
+
 static CDockManager::ConfigFlags StaticConfigFlags = CDockManager::DefaultNonOpaqueConfig;
+static CDockManager::PerformanceFlags StaticPerformanceFlags = CDockManager::DefaultPerformanceConfig;
+static int StaticSplitterResizeInterval = 0;
+
+
+/**
+ * Sorted index of the actions of an alphabetically sorted view menu.
+ * The index is a child of its menu and follows the actions of the menu via
+ * an event filter. The index caches the text each action is sorted by. If the
+ * text of an action changes, the action is moved to its new position in the
+ * index and in the menu. If an action is added to the menu by someone else,
+ * the menu may no longer be sorted and the index is marked as invalid.
+ */
+class CSortedMenuIndex : public QObject
+{
+public:
+	QMenu* Menu;
+	QVector<QAction*> Actions;
+	QHash<QAction*, QString> Texts;
+	bool Valid = true;
+	bool Inserting = false;
+
+	/**
+	 * Creates the index for the given menu
+	 */
+	CSortedMenuIndex(QMenu* Menu)
+		: QObject(Menu),
+		  Menu(Menu)
+	{
+		Menu->installEventFilter(this);
+	}
+
+	/**
+	 * Returns the position of the first action with a text greater than the
+	 * given text
+	 */
+	int upperBound(const QString& Text) const
+	{
+		auto it = std::upper_bound(Actions.begin(), Actions.end(), Text,
+			[this](const QString& t, QAction* a)
+			{
+				return t.compare(Texts.value(a), Qt::CaseInsensitive) < 0;
+			});
+		return it - Actions.begin();
+	}
+
+	/**
+	 * Returns the action at the given position or a nullptr if the position
+	 * is behind the last action
+	 */
+	QAction* actionAt(int Pos) const
+	{
+		return (Pos < Actions.count()) ? Actions[Pos] : nullptr;
+	}
+
+	/**
+	 * Inserts the given actions in front of the given position into the menu
+	 * and into the index. The actions need to be sorted.
+	 */
+	void insertActions(int Pos, const QList<QAction*>& NewActions)
+	{
+		// The menu moves actions that it already contains
+		for (auto Action : NewActions)
+		{
+			if (Texts.contains(Action))
+			{
+				if (Actions.indexOf(Action) < Pos)
+				{
+					--Pos;
+				}
+				removeAction(Action);
+			}
+		}
+
+		Inserting = true;
+		Menu->insertActions(actionAt(Pos), NewActions);
+		Inserting = false;
+		Actions.insert(Pos, NewActions.count(), nullptr);
+		for (auto Action : NewActions)
+		{
+			Texts.insert(Action, Action->text());
+			Actions[Pos++] = Action;
+		}
+	}
+
+	/**
+	 * Removes the given action from the index
+	 */
+	void removeAction(QAction* Action)
+	{
+		auto Text = Texts.value(Action);
+		auto it = std::lower_bound(Actions.begin(), Actions.end(), Text,
+			[this](QAction* a, const QString& t)
+			{
+				return Texts.value(a).compare(t, Qt::CaseInsensitive) < 0;
+			});
+		it = std::find(it, Actions.end(), Action);
+		if (it != Actions.end())
+		{
+			Actions.erase(it);
+		}
+		Texts.remove(Action);
+	}
+
+	/**
+	 * Moves the given action to the position of its current text
+	 */
+	void reposition(QAction* Action)
+	{
+		if (!Valid || !Texts.contains(Action) || Texts.value(Action) == Action->text())
+		{
+			return;
+		}
+
+		removeAction(Action);
+		insertActions(upperBound(Action->text()), {Action});
+	}
+
+	virtual bool eventFilter(QObject* Watched, QEvent* Event) override
+	{
+		Q_UNUSED(Watched);
+		if (Inserting || !Valid)
+		{
+			return false;
+		}
+
+		switch (Event->type())
+		{
+		case QEvent::ActionAdded:
+			Valid = false;
+			Actions.clear();
+			Texts.clear();
+			break;
+
+		case QEvent::ActionRemoved:
+			removeAction(static_cast<QActionEvent*>(Event)->action());
+			break;
+
+		case QEvent::ActionChanged:
+			{
+				// The action still iterates over its widgets here, so the
+				// menu is changed from the event loop
+				QPointer<QAction> Action = static_cast<QActionEvent*>(Event)->action();
+				if (Texts.value(Action) != Action->text())
+				{
+					QTimer::singleShot(0, this, [this, Action]()
+					{
+						if (Action)
+						{
+							reposition(Action);
+						}
+					});
+				}
+			}
+			break;
+
+		default:
+			break;
+		}
+		return false;
+	}
+}; // class CSortedMenuIndex
 
 /**
  * Private data class of CDockManager class (pimpl)
@@ -107,16 +291,36 @@ struct DockManagerPrivate
 	QList<CDockContainerWidget*> Containers;
 	CDockOverlay* ContainerOverlay;
 	CDockOverlay* DockAreaOverlay;
-	QMap<QString, CDockWidget*> DockWidgetsMap;
+	CDockWidgetRegistry DockWidgets;
 	QMap<QString, QByteArray> Perspectives;
 	QMap<QString, QMenu*> ViewMenuGroups;
 	QMenu* ViewMenu;
+	QHash<QMenu*, QPointer<CSortedMenuIndex>> SortedMenuIndices;
+	CViewMenuModel* ViewMenuModel = nullptr;
+	CViewMenuPopup* ViewMenuPopup = nullptr;
     CDockGroupMenu *GroupMenu = nullptr;
 	CDockManager::eViewMenuInsertionOrder MenuInsertionOrder = CDockManager::MenuAlphabeticallySorted;
 	bool RestoringState = false;
 	QVector<CFloatingDockContainer*> UninitializedFloatingWidgets;
 	CDockFocusController* FocusController = nullptr;
     CDockWidget* CentralWidget = nullptr;
+	int UpdateDepth = 0;
+	bool FlushingUpdates = false;
+	bool EmittingDeferredSignals = false;
+	bool LayoutChangedPending = false;
+	bool GroupMenusOutdated = false;
+	QHash<QSplitter*, QPointer<QSplitter>> PendingSplitterHandleUpdates;
+	QHash<CDockContainerWidget*, QPointer<CDockContainerWidget>> PendingTopLevelUpdates;
+	QList<CDockWidget*> PendingAddedDockWidgets;
+	QList<CDockWidget*> FlushedAddedDockWidgets;
+	QList<QPointer<CFloatingDockContainer>> FloatingWidgetPool;
+	int FloatingWidgetPoolSize = 0;
+	bool PrewarmingFloatingWidgets = false;
+	QList<QPointer<CDockAreaWidget>> DockAreaPool;
+	int DockAreaPoolSize = 0;
+	QCache<const QWidget*, ContentSnapshot> ContentSnapshots{DefaultContentSnapshotCacheSize};
+	QHash<int, QList<QPointer<CDockWidget>>> Interactions;
+	int LastInteractionId = 0;
 
 	/**
 	 * Private data constructor
@@ -164,9 +368,9 @@ struct DockManagerPrivate
 
 	void markDockWidgetsDirty()
 	{
-		for (auto DockWidget : DockWidgetsMap)
+		for (auto DockWidget : DockWidgets.dockWidgets())
 		{
-			DockWidget->setProperty("dirty", true);
+			DockWidget->setRestoreDirty(true);
 		}
 	}
 
@@ -184,6 +388,71 @@ struct DockManagerPrivate
 	 * Adds action to menu - optionally in sorted order
 	 */
 	void addActionToMenu(QAction* Action, QMenu* Menu, bool InsertSorted);
+
+	/**
+	 * Adds the given actions to menu - optionally in sorted order.
+	 * The sorted actions are merged into the sorted index of the menu, so
+	 * each run of actions between two existing actions is inserted with one
+	 * call
+	 */
+	void addActionsToMenu(const QList<QAction*>& Actions, QMenu* Menu, bool InsertSorted);
+
+	/**
+	 * Returns the sorted index of the given menu and creates it if the menu
+	 * has no actions yet. Returns a nullptr if the menu contains actions
+	 * that have not been added via the index.
+	 */
+	CSortedMenuIndex* sortedMenuIndex(QMenu* Menu);
+
+	/**
+	 * Returns the view menu group menu for the given group and creates it
+	 * if it does not exist yet. Returns the view menu if Group is empty
+	 */
+	QMenu* viewMenuGroup(const QString& Group, const QIcon& GroupIcon);
+
+	/**
+	 * Adds the given dock widget to the registry and connects its signals.
+	 * This is the only registration path of the dock manager. The signals
+	 * of an already registered dock widget are not connected a second time
+	 */
+	void registerDockWidget(CDockWidget* DockWidget);
+
+	/**
+	 * Emits the layoutChanged() signal or defers it until the outermost
+	 * update transaction ends
+	 */
+	void notifyLayoutChanged();
+
+	/**
+	 * Returns true, if side effects are deferred because an update
+	 * transaction is active or because the deferred signals are emitted
+	 * right now
+	 */
+	bool deferUpdates() const
+	{
+		return UpdateDepth > 0 || EmittingDeferredSignals;
+	}
+
+	/**
+	 * Emits the dockWidgetAdded() signals or defers them until the outermost
+	 * update transaction ends
+	 */
+	void notifyDockWidgetAdded(CDockWidget* DockWidget);
+
+	/**
+	 * Emits the dockWidgetAboutToBeRemoved() and dockWidgetRemoved()
+	 * signals for the given dock widget. If the dock widget has been
+	 * added in the current update transaction, its deferred signals are
+	 * cancelled and no signal is emitted. Returns false in this case
+	 */
+	bool notifyDockWidgetAboutToBeRemoved(CDockWidget* DockWidget);
+	void notifyDockWidgetRemoved(CDockWidget* DockWidget);
+
+	/**
+	 * Executes all side effects that have been deferred by the update
+	 * transaction
+	 */
+	void flushDeferredUpdates();
 };
 // struct DockManagerPrivate
 
@@ -195,9 +464,168 @@ DockManagerPrivate::DockManagerPrivate(CDockManager* _public) :
 }
 
 
+//============================================================================
+void DockManagerPrivate::registerDockWidget(CDockWidget* DockWidget)
+{
+	if (!DockWidgets.contains(DockWidget))
+	{
+		_this->connect(DockWidget, &CDockWidget::viewToggled, _this, [=](bool){
+			notifyLayoutChanged();
+		});
+	}
+	DockWidgets.add(DockWidget);
+	DockWidget->setDockManager(_this);
+}
+
+
+//============================================================================
+void DockManagerPrivate::notifyLayoutChanged()
+{
+	if (deferUpdates())
+	{
+		LayoutChangedPending = true;
+		return;
+	}
+
+	emit _this->layoutChanged();
+}
+
+
+//============================================================================
+void DockManagerPrivate::notifyDockWidgetAdded(CDockWidget* DockWidget)
+{
+	if (deferUpdates())
+	{
+		PendingAddedDockWidgets.append(DockWidget);
+		return;
+	}
+
+	emit _this->dockWidgetAdded(DockWidget);
+	emit _this->dockWidgetsAdded({DockWidget});
+}
+
+
+//============================================================================
+bool DockManagerPrivate::notifyDockWidgetAboutToBeRemoved(CDockWidget* DockWidget)
+{
+	// A dock widget that is added and removed in the same transaction has
+	// never been reported, so it is not reported at all
+	FlushedAddedDockWidgets.removeAll(DockWidget);
+	if (PendingAddedDockWidgets.removeAll(DockWidget))
+	{
+		return false;
+	}
+
+	emit _this->dockWidgetAboutToBeRemoved(DockWidget);
+	return true;
+}
+
+
+//============================================================================
+void DockManagerPrivate::notifyDockWidgetRemoved(CDockWidget* DockWidget)
+{
+	// Removals are never deferred because the dock widget may be deleted
+	// right after its removal
+	emit _this->dockWidgetRemoved(DockWidget);
+}
+
+
+//============================================================================
+void DockManagerPrivate::flushDeferredUpdates()
+{
+	// The slots connected to the deferred signals may add dock widgets or
+	// start their own update transactions. The side effects of these slots
+	// are deferred again and executed by the following loop iterations
+	FlushingUpdates = true;
+	while (!PendingSplitterHandleUpdates.isEmpty() || !PendingTopLevelUpdates.isEmpty()
+		|| !PendingAddedDockWidgets.isEmpty() || GroupMenusOutdated)
+	{
+		auto SplitterHandleUpdates = std::move(PendingSplitterHandleUpdates);
+		PendingSplitterHandleUpdates.clear();
+		for (auto& Splitter : SplitterHandleUpdates)
+		{
+			if (!Splitter)
+			{
+				continue;
+			}
+			auto Container = internal::findParent<CDockContainerWidget*>(Splitter.data());
+			if (Container)
+			{
+				Container->updateSplitterHandles(Splitter);
+			}
+		}
+
+		auto TopLevelUpdates = std::move(PendingTopLevelUpdates);
+		PendingTopLevelUpdates.clear();
+		for (auto& Container : TopLevelUpdates)
+		{
+			if (!Container)
+			{
+				continue;
+			}
+			auto FloatingWidget = Container->floatingWidget();
+			if (FloatingWidget)
+			{
+				FloatingWidget->onDockAreasAddedOrRemoved();
+			}
+			auto TopLevelDockWidget = Container->topLevelDockWidget();
+			if (TopLevelDockWidget)
+			{
+				TopLevelDockWidget->emitTopLevelChanged(true);
+			}
+		}
+
+		// Dock widgets that are removed again - and so all deleted dock
+		// widgets - are taken out of both lists by
+		// notifyDockWidgetAboutToBeRemoved()
+		EmittingDeferredSignals = true;
+		while (!PendingAddedDockWidgets.isEmpty())
+		{
+			auto DockWidget = PendingAddedDockWidgets.takeFirst();
+			FlushedAddedDockWidgets.append(DockWidget);
+			emit _this->dockWidgetAdded(DockWidget);
+		}
+		auto AddedDockWidgets = std::move(FlushedAddedDockWidgets);
+		FlushedAddedDockWidgets.clear();
+		if (!AddedDockWidgets.isEmpty())
+		{
+			emit _this->dockWidgetsAdded(AddedDockWidgets);
+		}
+		EmittingDeferredSignals = false;
+
+		if (GroupMenusOutdated)
+		{
+			GroupMenusOutdated = false;
+			for (auto Container : Containers)
+			{
+				for (int i = 0; i < Container->dockAreaCount(); ++i)
+				{
+					Container->dockArea(i)->updateGroupMenu();
+				}
+			}
+		}
+	}
+	FlushingUpdates = false;
+
+	_this->dumpLayout();
+	if (LayoutChangedPending)
+	{
+		LayoutChangedPending = false;
+		emit _this->layoutChanged();
+	}
+}
+
+
 //============================================================================
 void DockManagerPrivate::loadStylesheet()
 {
+	if (CDockManager::testConfigFlag(CDockManager::ProxyStyleRendering))
+	{
+		// The widgets of the docking system set the dock style themselves
+		_this->setStyleSheet(QString());
+		return;
+	}
+
 	initResource();
 	QString Result;
 	QString FileName = ":ads/stylesheets/";
@@ -330,13 +758,14 @@ bool DockManagerPrivate::restoreStateFromXml(const QByteArray &state,  int versi
 
     if (!Testing)
     {
-		// Delete remaining empty floating widgets
+		// Release remaining empty floating widgets. Releasing removes them
+		// from the list of floating widgets
 		int FloatingWidgetIndex = DockContainerCount - 1;
-		for (int i = FloatingWidgetIndex; i < FloatingWidgets.count(); ++i)
+		auto EmptyFloatingWidgets = FloatingWidgets.mid(FloatingWidgetIndex);
+		for (auto floatingWidget : EmptyFloatingWidgets)
 		{
-			auto* floatingWidget = FloatingWidgets[i];
 			_this->removeDockContainer(floatingWidget->dockContainer());
-			floatingWidget->deleteLater();
+			_this->releaseFloatingWidget(floatingWidget);
 		}
     }
 
@@ -401,16 +830,16 @@ void DockManagerPrivate::restoreDockWidgetsOpenState()
     // function are invisible to the user now and have no assigned dock area
     // They do not belong to any dock container, until the user toggles the
     // toggle view action the next time
-    for (auto DockWidget : DockWidgetsMap)
+    for (auto DockWidget : DockWidgets.dockWidgets())
     {
-    	if (DockWidget->property(internal::DirtyProperty).toBool())
+    	if (DockWidget->isRestoreDirty())
     	{
     		DockWidget->flagAsUnassigned();
             emit DockWidget->viewToggled(false);
     	}
     	else
     	{
-    		DockWidget->toggleViewInternal(!DockWidget->property(internal::ClosedProperty).toBool());
+    		DockWidget->toggleViewInternal(!DockWidget->isRestoreClosed());
     	}
     }
 }
@@ -429,12 +858,7 @@ void DockManagerPrivate::restoreDockAreasIndices()
     	for (int i = 0; i < DockContainer->dockAreaCount(); ++i)
     	{
     		CDockAreaWidget* DockArea = DockContainer->dockArea(i);
-    		QString DockWidgetName = DockArea->property("currentDockWidget").toString();
-    		CDockWidget* DockWidget = nullptr;
-    		if (!DockWidgetName.isEmpty())
-    		{
-    			DockWidget = _this->findDockWidget(DockWidgetName);
-    		}
+    		CDockWidget* DockWidget = DockArea->restoredCurrentDockWidget();
 
     		if (!DockWidget || DockWidget->isClosed())
     		{
@@ -523,31 +947,117 @@ bool DockManagerPrivate::restoreFloatingGeometry(const QByteArray& State, int ve
 }
 
 
+//============================================================================
+static bool actionTextLessThan(const QAction* a, const QAction* b)
+{
+	return a->text().compare(b->text(), Qt::CaseInsensitive) < 0;
+}
+
+
+//============================================================================
+CSortedMenuIndex* DockManagerPrivate::sortedMenuIndex(QMenu* Menu)
+{
+	auto Index = SortedMenuIndices.value(Menu);
+	if (!Index && Menu->actions().isEmpty())
+	{
+		Index = new CSortedMenuIndex(Menu);
+		SortedMenuIndices.insert(Menu, Index);
+	}
+	return (Index && Index->Valid) ? Index.data() : nullptr;
+}
+
+
 //============================================================================
 void DockManagerPrivate::addActionToMenu(QAction* Action, QMenu* Menu, bool InsertSorted)
 {
-	if (InsertSorted)
+	if (!InsertSorted)
 	{
-		auto Actions = Menu->actions();
-		auto it = std::find_if(Actions.begin(), Actions.end(),
-			[&Action](const QAction* a)
-			{
-				return a->text().compare(Action->text(), Qt::CaseInsensitive) > 0;
-			});
+		Menu->addAction(Action);
+		return;
+	}
+
+	// Binary search in the sorted index of the menu. If the menu also
+	// contains actions that have not been added by the dock manager, the
+	// menu actions are searched linearly
+	auto Index = sortedMenuIndex(Menu);
+	if (Index)
+	{
+		Index->insertActions(Index->upperBound(Action->text()), {Action});
+		return;
+	}
+
+	auto Actions = Menu->actions();
+	auto it = std::find_if(Actions.begin(), Actions.end(),
+		[&Action](const QAction* a)
+		{
+			return a->text().compare(Action->text(), Qt::CaseInsensitive) > 0;
+		});
+	Menu->insertAction((it == Actions.end()) ? nullptr : *it, Action);
+}
+
+
+//============================================================================
+void DockManagerPrivate::addActionsToMenu(const QList<QAction*>& Actions,
+	QMenu* Menu, bool InsertSorted)
+{
+	if (!InsertSorted)
+	{
+		Menu->addActions(Actions);
+		return;
+	}
 
-		if (it == Actions.end())
+	auto Index = sortedMenuIndex(Menu);
+	if (!Index)
+	{
+		for (auto Action : Actions)
 		{
-			Menu->addAction(Action);
+			addActionToMenu(Action, Menu, InsertSorted);
 		}
-		else
+		return;
+	}
+
+	auto NewActions = Actions;
+	std::stable_sort(NewActions.begin(), NewActions.end(), actionTextLessThan);
+	int j = 0;
+	while (j < NewActions.count())
+	{
+		// Equal texts are inserted behind the existing actions like in
+		// addActionToMenu()
+		int Pos = Index->upperBound(NewActions[j]->text());
+		QAction* Before = Index->actionAt(Pos);
+		QList<QAction*> Run;
+		while (j < NewActions.count() && (!Before
+			|| NewActions[j]->text().compare(Index->Texts.value(Before), Qt::CaseInsensitive) < 0))
 		{
-			Menu->insertAction(*it, Action);
+			Run.append(NewActions[j++]);
 		}
+		Index->insertActions(Pos, Run);
 	}
-	else
+}
+
+
+//============================================================================
+QMenu* DockManagerPrivate::viewMenuGroup(const QString& Group, const QIcon& GroupIcon)
+{
+	if (Group.isEmpty())
 	{
-		Menu->addAction(Action);
+		return ViewMenu;
 	}
+
+	QMenu* GroupMenu = ViewMenuGroups.value(Group, 0);
+	if (!GroupMenu)
+	{
+		GroupMenu = new QMenu(Group, _this);
+		GroupMenu->setIcon(GroupIcon);
+		addActionToMenu(GroupMenu->menuAction(), ViewMenu,
+			CDockManager::MenuAlphabeticallySorted == MenuInsertionOrder);
+		ViewMenuGroups.insert(Group, GroupMenu);
+	}
+	else if (GroupMenu->icon().isNull() && !GroupIcon.isNull())
+	{
+		GroupMenu->setIcon(GroupIcon);
+	}
+	return GroupMenu;
 }
 
 //============================================================================
@@ -564,14 +1074,15 @@ CDockManager::CDockManager(QWidget *parent) :
 	}
 
 	d->ViewMenu = new QMenu(tr("Show View"), this);
+	d->ViewMenuModel = new CViewMenuModel(this);
     d->GroupMenu = new CDockGroupMenu(this);
 	d->DockAreaOverlay = new CDockOverlay(this, CDockOverlay::ModeDockAreaOverlay);
 	d->ContainerOverlay = new CDockOverlay(this, CDockOverlay::ModeContainerOverlay);
 	d->Containers.append(this);
 	d->loadStylesheet();
 
-    connect(this, &CDockContainerWidget::splitterMoved, this, &CDockManager::layoutChanged);
-    connect(this, &CDockContainerWidget::dockAreasAdded, this, &CDockManager::layoutChanged);
+    connect(this, &CDockContainerWidget::splitterMoved, this, [this]{ d->notifyLayoutChanged(); });
+    connect(this, &CDockContainerWidget::dockAreasAdded, this, [this]{ d->notifyLayoutChanged(); });
 
 	if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
 	{
@@ -579,6 +1090,7 @@ CDockManager::CDockManager(QWidget *parent) :
 	}
 
 #ifdef Q_OS_LINUX
+	internal::xcb_intern_atoms();
 	window()->installEventFilter(this);
 #endif
 }
@@ -591,6 +1103,20 @@ CDockManager::~CDockManager()
 	{
 		delete FloatingWidget;
 	}
+	auto FloatingWidgetPool = d->FloatingWidgetPool;
+	for (auto FloatingWidget : FloatingWidgetPool)
+	{
+		delete FloatingWidget;
+	}
+	auto DockAreaPool = d->DockAreaPool;
+	for (auto DockArea : DockAreaPool)
+	{
+		delete DockArea;
+	}
+	// The toggle view actions are destroyed with the dock widgets after
+	// this destructor - so the menus should not maintain their sorted
+	// indices any longer
+	qDeleteAll(d->SortedMenuIndices);
 	delete d;
 }
 
@@ -602,31 +1128,32 @@ bool CDockManager::eventFilter(QObject *obj, QEvent *e)
 	// Required because on some WMs Tool windows can't be maximized.
 
 	// Window always on top of the MainWindow.
-	if (e->type() == QEvent::WindowActivate)
+	if (e->type() == QEvent::WindowActivate || e->type() == QEvent::WindowDeactivate)
 	{
+		bool Activate = (e->type() == QEvent::WindowActivate);
+		QVector<WId> Windows;
+		QList<CFloatingDockContainer*> RaiseWindows;
 		for (auto _window : floatingWidgets())
 		{
 			if (!_window->isVisible() || window()->isMinimized())
 			{
 				continue;
 			}
-			// setWindowFlags(Qt::WindowStaysOnTopHint) will hide the window and thus requires a show call.
-			// This then leads to flickering and a nasty endless loop (also buggy behaviour on Ubuntu).
-			// So we just do it ourself.
-			internal::xcb_update_prop(true, _window->window()->winId(),
-				"_NET_WM_STATE", "_NET_WM_STATE_ABOVE", "_NET_WM_STATE_STAYS_ON_TOP");
-		}
-	}
-	else if (e->type() == QEvent::WindowDeactivate)
-	{
-		for (auto _window : floatingWidgets())
-		{
-			if (!_window->isVisible() || window()->isMinimized())
+			Windows.append(_window->window()->winId());
+			if (!Activate)
 			{
-				continue;
+				RaiseWindows.append(_window);
 			}
-			internal::xcb_update_prop(false, _window->window()->winId(),
-				"_NET_WM_STATE", "_NET_WM_STATE_ABOVE", "_NET_WM_STATE_STAYS_ON_TOP");
+		}
+
+		// setWindowFlags(Qt::WindowStaysOnTopHint) will hide the window and thus requires a show call.
+		// This then leads to flickering and a nasty endless loop (also buggy behaviour on Ubuntu).
+		// So we just do it ourself. The client messages for all windows are
+		// sent with one flush.
+		internal::xcb_update_prop(Activate, Windows, internal::XcbAtomNetWmState,
+			internal::XcbAtomNetWmStateAbove, internal::XcbAtomNetWmStateStaysOnTop);
+		for (auto _window : RaiseWindows)
+		{
 			_window->raise();
 		}
 	}
@@ -662,6 +1189,13 @@ bool CDockManager::eventFilter(QObject *obj, QEvent *e)
 //============================================================================
 void CDockManager::registerFloatingWidget(CFloatingDockContainer* FloatingWidget)
 {
+	// Prewarmed floating widgets go into the pool and not into the list
+	// of active floating widgets
+	if (d->PrewarmingFloatingWidgets)
+	{
+		return;
+	}
+
 	d->FloatingWidgets.append(FloatingWidget);
     emit floatingWidgetCreated(FloatingWidget);
     ADS_PRINT("d->FloatingWidgets.count() " << d->FloatingWidgets.count());
@@ -675,10 +1209,236 @@ void CDockManager::removeFloatingWidget(CFloatingDockContainer* FloatingWidget)
 }
 
 
+//============================================================================
+CFloatingDockContainer* CDockManager::takePooledFloatingWidget()
+{
+	while (!d->FloatingWidgetPool.isEmpty())
+	{
+		auto FloatingWidget = d->FloatingWidgetPool.takeLast();
+		if (!FloatingWidget)
+		{
+			continue;
+		}
+
+		// The container has been registered when the floating widget
+		// was created, so we do not connect it a second time here
+		d->Containers.append(FloatingWidget->dockContainer());
+		registerFloatingWidget(FloatingWidget);
+		return FloatingWidget;
+	}
+
+	return nullptr;
+}
+
+
+//============================================================================
+void CDockManager::releaseFloatingWidget(CFloatingDockContainer* FloatingWidget)
+{
+	if (d->FloatingWidgetPool.count() >= d->FloatingWidgetPoolSize)
+	{
+		FloatingWidget->deleteLater();
+		return;
+	}
+
+	removeFloatingWidget(FloatingWidget);
+	removeDockContainer(FloatingWidget->dockContainer());
+	// The floating widget may still be in the middle of its own mouse event
+	// handling, so it is reset from the event loop like it would have been
+	// deleted by deleteLater()
+	QPointer<CFloatingDockContainer> Released(FloatingWidget);
+	QTimer::singleShot(0, this, [this, Released]()
+	{
+		if (!Released)
+		{
+			return;
+		}
+
+		// A floating widget may be released twice, e.g. by a closed dock
+		// widget and by its empty dock area
+		if (d->FloatingWidgetPool.contains(Released))
+		{
+			return;
+		}
+
+		Released->resetForReuse();
+		if (d->FloatingWidgetPool.count() < d->FloatingWidgetPoolSize)
+		{
+			d->FloatingWidgetPool.append(Released);
+		}
+		else
+		{
+			Released->deleteLater();
+		}
+	});
+}
+
+
+//============================================================================
+void CDockManager::setFloatingWidgetPoolSize(int Size)
+{
+	d->FloatingWidgetPoolSize = qMax(0, Size);
+	while (d->FloatingWidgetPool.count() > d->FloatingWidgetPoolSize)
+	{
+		auto FloatingWidget = d->FloatingWidgetPool.takeLast();
+		if (FloatingWidget)
+		{
+			FloatingWidget->deleteLater();
+		}
+	}
+}
+
+
+//============================================================================
+int CDockManager::floatingWidgetPoolSize() const
+{
+	return d->FloatingWidgetPoolSize;
+}
+
+
+//============================================================================
+void CDockManager::prewarmFloatingWidgetPool()
+{
+	d->FloatingWidgetPool.removeAll(nullptr);
+	d->PrewarmingFloatingWidgets = true;
+	while (d->FloatingWidgetPool.count() < d->FloatingWidgetPoolSize)
+	{
+		auto FloatingWidget = new CFloatingDockContainer(this);
+		// Creating the native window is the expensive part of showing a
+		// new floating widget for the first time
+		FloatingWidget->winId();
+		removeDockContainer(FloatingWidget->dockContainer());
+		d->FloatingWidgetPool.append(FloatingWidget);
+	}
+	d->PrewarmingFloatingWidgets = false;
+}
+
+
+//============================================================================
+CDockAreaWidget* CDockManager::takePooledDockArea(CDockContainerWidget* Container)
+{
+	while (!d->DockAreaPool.isEmpty())
+	{
+		auto DockArea = d->DockAreaPool.takeLast();
+		if (!DockArea)
+		{
+			continue;
+		}
+
+		DockArea->setParent(Container);
+		DockArea->setDockContainer(Container);
+		// The area may have been hidden explicitly before it was released
+		DockArea->setVisible(true);
+		// The area has been reset to the state of a new dock area, so the
+		// application needs to apply its customizations again
+		emit dockAreaCreated(DockArea);
+		return DockArea;
+	}
+
+	return nullptr;
+}
+
+
+//============================================================================
+void CDockManager::releaseDockArea(CDockAreaWidget* DockArea)
+{
+	if (d->DockAreaPool.count() >= d->DockAreaPoolSize)
+	{
+		DockArea->deleteLater();
+		return;
+	}
+
+	// Like with deleteLater(), the caller may still access the area until
+	// control returns to the event loop, so it is reset from there
+	QPointer<CDockAreaWidget> Released(DockArea);
+	QTimer::singleShot(0, this, [this, Released]()
+	{
+		if (!Released)
+		{
+			return;
+		}
+
+		if (Released->dockWidgetsCount() || d->DockAreaPool.count() >= d->DockAreaPoolSize)
+		{
+			Released->deleteLater();
+			return;
+		}
+
+		Released->resetForReuse();
+		d->DockAreaPool.append(Released);
+	});
+}
+
+
+//============================================================================
+void CDockManager::setDockAreaPoolSize(int Size)
+{
+	d->DockAreaPoolSize = qMax(0, Size);
+	while (d->DockAreaPool.count() > d->DockAreaPoolSize)
+	{
+		auto DockArea = d->DockAreaPool.takeLast();
+		if (DockArea)
+		{
+			DockArea->deleteLater();
+		}
+	}
+}
+
+
+//============================================================================
+int CDockManager::dockAreaPoolSize() const
+{
+	return d->DockAreaPoolSize;
+}
+
+
+//============================================================================
+void CDockManager::cacheContentSnapshot(QWidget* Widget, const QPixmap& Pixmap)
+{
+	int Cost = qMax(1, Pixmap.width() * Pixmap.height() * Pixmap.depth() / (8 * 1024));
+	auto Snapshot = new ContentSnapshot{Widget, Pixmap};
+	// QCache deletes the snapshot if it is bigger than the whole budget
+	d->ContentSnapshots.insert(Widget, Snapshot, Cost);
+}
+
+
+//============================================================================
+QPixmap CDockManager::contentSnapshot(QWidget* Widget) const
+{
+	auto Snapshot = d->ContentSnapshots.object(Widget);
+	if (!Snapshot || Snapshot->Widget != Widget)
+	{
+		return QPixmap();
+	}
+
+	return Snapshot->Pixmap;
+}
+
+
+//============================================================================
+void CDockManager::removeContentSnapshot(QWidget* Widget)
+{
+	d->ContentSnapshots.remove(Widget);
+}
+
+
+//============================================================================
+void CDockManager::setContentSnapshotCacheSize(int KBytes)
+{
+	d->ContentSnapshots.setMaxCost(qMax(0, KBytes));
+}
+
+
+//============================================================================
+int CDockManager::contentSnapshotCacheSize() const
+{
+	return d->ContentSnapshots.maxCost();
+}
+
+
 //============================================================================
 void CDockManager::registerDockContainer(CDockContainerWidget* DockContainer)
 {
-    connect(DockContainer, &CDockContainerWidget::dockAreasAdded, this, &CDockManager::layoutChanged);
+    connect(DockContainer, &CDockContainerWidget::dockAreasAdded, this, [this]{ d->notifyLayoutChanged(); });
 	d->Containers.append(DockContainer);
 }
 
@@ -782,7 +1542,17 @@ bool CDockManager::restoreState(const QByteArray &state, int version)
 	}
 	d->RestoringState = true;
 	emit restoringState();
+	// QVector::toList() is deprecated since Qt 5.14 and the range constructor
+	// of QList does not exist before, so the list is copied manually
+	QList<CDockWidget*> DockWidgets;
+	DockWidgets.reserve(d->DockWidgets.count());
+	for (auto DockWidget : d->DockWidgets.dockWidgets())
+	{
+		DockWidgets.append(DockWidget);
+	}
+	int InteractionId = beginInteraction(DockWidgets);
 	bool Result = d->restoreState(state, version);
+	endInteraction(InteractionId);
 	d->RestoringState = false;
 	if (!IsHidden)
 	{
@@ -863,10 +1633,7 @@ bool CDockManager::restoreFloatingGeometry(const QByteArray &state, int version)
 //============================================================================
 CFloatingDockContainer* CDockManager::addDockWidgetFloating(CDockWidget* Dockwidget, bool hide)
 {
-	d->DockWidgetsMap.insert(Dockwidget->objectName(), Dockwidget);
-    connect(Dockwidget, &CDockWidget::viewToggled, [=](bool){
-        emit layoutChanged();
-    });
+	d->registerDockWidget(Dockwidget);
 	CDockAreaWidget* OldDockArea = Dockwidget->dockAreaWidget();
 	if (OldDockArea)
 	{
@@ -874,7 +1641,7 @@ CFloatingDockContainer* CDockManager::addDockWidgetFloating(CDockWidget* Dockwid
 	}
 
 	Dockwidget->setDockManager(this);
-	CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(Dockwidget);
+	CFloatingDockContainer* FloatingWidget = CFloatingDockContainer::createFloatingWidget(Dockwidget);
 	FloatingWidget->resize(Dockwidget->size());
     if (isVisible() && !hide)
 	{
@@ -889,7 +1656,7 @@ CFloatingDockContainer* CDockManager::addDockWidgetFloating(CDockWidget* Dockwid
         Dockwidget->closeDockWidget();
         FloatingWidget->hide();
     }
-    emit dockWidgetAdded(Dockwidget);
+    d->notifyDockWidgetAdded(Dockwidget);
     return FloatingWidget;
 }
 
@@ -915,12 +1682,9 @@ void CDockManager::showEvent(QShowEvent *event)
 CDockAreaWidget* CDockManager::addDockWidget(DockWidgetArea area,
 	CDockWidget* Dockwidget, CDockAreaWidget* DockAreaWidget)
 {
-	d->DockWidgetsMap.insert(Dockwidget->objectName(), Dockwidget);
-    connect(Dockwidget, &CDockWidget::viewToggled, [=](bool){
-        emit layoutChanged();
-    });
+	d->registerDockWidget(Dockwidget);
     auto w = CDockContainerWidget::addDockWidget(area, Dockwidget, DockAreaWidget);
-    emit dockWidgetAdded(Dockwidget);
+    d->notifyDockWidgetAdded(Dockwidget);
     return w;
 }
 
@@ -953,21 +1717,217 @@ CDockAreaWidget* CDockManager::addDockWidgetTabToArea(CDockWidget* Dockwidget,
 }
 
 
+//============================================================================
+CDockAreaWidget* CDockManager::addDockWidgetsTabToArea(const QList<CDockWidget*>& DockWidgets,
+	CDockAreaWidget* DockAreaWidget)
+{
+	if (DockWidgets.isEmpty() || !DockAreaWidget)
+	{
+		return DockAreaWidget;
+	}
+
+	CDockManagerUpdateGuard Guard(this);
+	for (auto Dockwidget : DockWidgets)
+	{
+		d->registerDockWidget(Dockwidget);
+		CDockAreaWidget* OldDockArea = Dockwidget->dockAreaWidget();
+		if (OldDockArea)
+		{
+			OldDockArea->removeDockWidget(Dockwidget);
+		}
+	}
+
+	DockAreaWidget->addDockWidgets(DockWidgets);
+	for (auto Dockwidget : DockWidgets)
+	{
+		d->notifyDockWidgetAdded(Dockwidget);
+	}
+	return DockAreaWidget;
+}
+
+
+//============================================================================
+CDockAreaWidget* CDockManager::addDockWidgetsTab(DockWidgetArea area,
+	const QList<CDockWidget*>& DockWidgets)
+{
+	if (DockWidgets.isEmpty())
+	{
+		return nullptr;
+	}
+
+	CDockManagerUpdateGuard Guard(this);
+	auto AreaWidget = addDockWidgetTab(area, DockWidgets.first());
+	return addDockWidgetsTabToArea(DockWidgets.mid(1), AreaWidget);
+}
+
+
+//============================================================================
+QList<CDockAreaWidget*> CDockManager::addDockWidgets(const QList<CDockWidgetInsertion>& Insertions)
+{
+	QList<CDockAreaWidget*> DockAreas;
+	DockAreas.reserve(Insertions.count());
+	auto targetArea = [&](int Index)
+	{
+		const auto& Insertion = Insertions.at(Index);
+		if (Insertion.TargetInsertion >= 0
+		 && Insertion.TargetInsertion < qMin(Index, DockAreas.count()))
+		{
+			return DockAreas.at(Insertion.TargetInsertion);
+		}
+		return Insertion.TargetArea;
+	};
+
+	CDockManagerUpdateGuard Guard(this);
+	auto Containers = d->Containers;
+	for (auto Container : Containers)
+	{
+		Container->beginBulkInsertion();
+	}
+
+	int i = 0;
+	while (i < Insertions.count())
+	{
+		const auto& Insertion = Insertions.at(i);
+		auto TargetArea = targetArea(i);
+		if (!TargetArea || CenterDockWidgetArea != Insertion.Area)
+		{
+			DockAreas.append(addDockWidget(Insertion.Area, Insertion.DockWidget, TargetArea));
+			++i;
+			continue;
+		}
+
+		// Collect all consecutive tabs for the same target area
+		QList<CDockWidget*> Tabs;
+		int End = i;
+		while (End < Insertions.count() && CenterDockWidgetArea == Insertions.at(End).Area
+			&& targetArea(End) == TargetArea)
+		{
+			Tabs.append(Insertions.at(End).DockWidget);
+			++End;
+		}
+		addDockWidgetsTabToArea(Tabs, TargetArea);
+		for (; i < End; ++i)
+		{
+			DockAreas.append(TargetArea);
+		}
+	}
+
+	for (auto Container : Containers)
+	{
+		Container->endBulkInsertion();
+	}
+	return DockAreas;
+}
+
+
+//============================================================================
+bool CDockManager::buildLayout(const CDockLayout& Layout,
+	const QList<CDockWidget*>& DockWidgets)
+{
+	if (dockAreaCount())
+	{
+		qWarning("CDockManager::buildLayout() requires a dock manager without dock areas");
+		return false;
+	}
+
+	if (DockWidgets.contains(nullptr))
+	{
+		qWarning("CDockManager::buildLayout() called with a null dock widget");
+		return false;
+	}
+
+	// Nothing is registered before the layout has been validated, so an
+	// invalid layout leaves the dock manager unchanged
+	CDockManagerUpdateGuard Guard(this);
+	for (auto DockWidget : DockWidgets)
+	{
+		if (d->DockWidgets.contains(DockWidget))
+		{
+			continue;
+		}
+		d->registerDockWidget(DockWidget);
+		d->notifyDockWidgetAdded(DockWidget);
+	}
+
+	// The main container is empty, so building its layout cannot fail
+	CDockContainerWidget::buildLayout(Layout.root());
+
+	for (const auto& Window : Layout.floatingWindows())
+	{
+		// Like createFloatingWidget(), reuse a pooled floating widget first
+		auto FloatingWidget = takePooledFloatingWidget();
+		if (!FloatingWidget)
+		{
+			FloatingWidget = new CFloatingDockContainer(this);
+		}
+		FloatingWidget->dockContainer()->buildLayout(Window.Root);
+		if (!FloatingWidget->dockContainer()->dockAreaCount())
+		{
+			releaseFloatingWidget(FloatingWidget);
+			continue;
+		}
+
+		if (Window.Geometry.isValid())
+		{
+			FloatingWidget->setGeometry(Window.Geometry);
+		}
+		FloatingWidget->onDockAreasAddedOrRemoved();
+		if (isVisible())
+		{
+			FloatingWidget->show();
+		}
+		else
+		{
+			d->UninitializedFloatingWidgets.append(FloatingWidget);
+		}
+	}
+
+	// Like in restoreState(), dock widgets the layout does not reference are
+	// invisible and do not belong to any dock container until the user
+	// toggles their toggle view action
+	for (auto DockWidget : DockWidgets)
+	{
+		if (!DockWidget->dockAreaWidget())
+		{
+			DockWidget->flagAsUnassigned();
+			emit DockWidget->viewToggled(false);
+		}
+	}
+
+	for (auto Container : d->Containers)
+	{
+		auto TopLevelDockWidget = Container->topLevelDockWidget();
+		if (TopLevelDockWidget)
+		{
+			TopLevelDockWidget->emitTopLevelChanged(true);
+		}
+	}
+	d->notifyLayoutChanged();
+	return true;
+}
+
+
 //============================================================================
 CDockWidget* CDockManager::findDockWidget(const QString& ObjectName) const
 {
-	return d->DockWidgetsMap.value(ObjectName, nullptr);
+	return d->DockWidgets.find(ObjectName);
 }
 
 //============================================================================
 void CDockManager::removeDockWidget(CDockWidget* Dockwidget)
 {
-	emit dockWidgetAboutToBeRemoved(Dockwidget);
-	d->DockWidgetsMap.remove(Dockwidget->objectName());
+	bool Notify = d->notifyDockWidgetAboutToBeRemoved(Dockwidget);
+	// Disconnect the signals connected by registerDockWidget(), so that
+	// adding the dock widget again does not connect them twice
+	disconnect(Dockwidget, &CDockWidget::viewToggled, this, nullptr);
+	d->DockWidgets.remove(Dockwidget);
 	CDockContainerWidget::removeDockWidget(Dockwidget);
     d->GroupMenu->removeWidget(Dockwidget);
 	Dockwidget->setDockManager(nullptr);
-    emit dockWidgetRemoved(Dockwidget);
+	if (Notify)
+	{
+		d->notifyDockWidgetRemoved(Dockwidget);
+	}
 }
 
 //============================================================================
@@ -977,13 +1937,7 @@ void CDockManager::renameDockWidget(CDockWidget *Dockwidget, const QString &name
     if (oldName == name) {
         return;
     }
-    CDockWidget *widget = nullptr;
-    for (auto it = d->DockWidgetsMap.begin(); it != d->DockWidgetsMap.end(); ++it) {
-        if (it.value() == Dockwidget) {
-            widget = Dockwidget;
-            break;
-        }
-    }
+    CDockWidget *widget = d->DockWidgets.contains(Dockwidget) ? Dockwidget : nullptr;
     if (widget) {
         // rename title of floating window if widget placed in it
         // and title equal to old name
@@ -997,18 +1951,31 @@ void CDockManager::renameDockWidget(CDockWidget *Dockwidget, const QString &name
             }
         }
 
-        d->DockWidgetsMap.remove(Dockwidget->objectName());
         Dockwidget->renameDockWidget(name, objectName);
-        d->DockWidgetsMap[Dockwidget->objectName()] = Dockwidget;
+        d->DockWidgets.updateName(Dockwidget);
+        d->GroupMenu->updateWidget(Dockwidget);
     }
-    d->GroupMenu->renameAction(Dockwidget->getGroupName(), oldName, name);
     emit dockWidgetRenamed(Dockwidget);
 }
 
 //============================================================================
 QMap<QString, CDockWidget*> CDockManager::dockWidgetsMap() const
 {
-	return d->DockWidgetsMap;
+	return d->DockWidgets.toMap();
+}
+
+
+//============================================================================
+const CDockWidgetRegistry& CDockManager::dockWidgetRegistry() const
+{
+	return d->DockWidgets;
+}
+
+
+//============================================================================
+void CDockManager::onDockWidgetGroupChanged(CDockWidget* DockWidget)
+{
+	d->DockWidgets.updateGroup(DockWidget);
 }
 
 
@@ -1136,7 +2103,7 @@ CDockAreaWidget* CDockManager::setCentralWidget(CDockWidget* widget)
 
 	// Setting a central widget is now allowed if there are already other
 	// dock widgets.
-	if (!d->DockWidgetsMap.isEmpty())
+	if (!d->DockWidgets.isEmpty())
 	{
 		qWarning("Setting a central widget not possible - the central widget need to be the first "
 			"dock widget that is added to the dock manager.");
@@ -1158,29 +2125,22 @@ QAction* CDockManager::addToggleViewActionToMenu(QAction* ToggleViewAction,
 	const QString& Group, const QIcon& GroupIcon)
 {
 	bool AlphabeticallySorted = (MenuAlphabeticallySorted == d->MenuInsertionOrder);
-	if (!Group.isEmpty())
-	{
-		QMenu* GroupMenu = d->ViewMenuGroups.value(Group, 0);
-		if (!GroupMenu)
-		{
-			GroupMenu = new QMenu(Group, this);
-			GroupMenu->setIcon(GroupIcon);
-			d->addActionToMenu(GroupMenu->menuAction(), d->ViewMenu, AlphabeticallySorted);
-			d->ViewMenuGroups.insert(Group, GroupMenu);
-		}
-		else if (GroupMenu->icon().isNull() && !GroupIcon.isNull())
-		{
-			GroupMenu->setIcon(GroupIcon);
-		}
+	QMenu* Menu = d->viewMenuGroup(Group, GroupIcon);
+	d->addActionToMenu(ToggleViewAction, Menu, AlphabeticallySorted);
+	d->ViewMenuModel->addActions({ToggleViewAction}, Group);
+	return Group.isEmpty() ? ToggleViewAction : Menu->menuAction();
+}
 
-		d->addActionToMenu(ToggleViewAction, GroupMenu, AlphabeticallySorted);
-		return GroupMenu->menuAction();
-	}
-	else
-	{
-		d->addActionToMenu(ToggleViewAction, d->ViewMenu, AlphabeticallySorted);
-		return ToggleViewAction;
-	}
+
+//============================================================================
+QAction* CDockManager::addToggleViewActionsToMenu(const QList<QAction*>& ToggleViewActions,
+	const QString& Group, const QIcon& GroupIcon)
+{
+	bool AlphabeticallySorted = (MenuAlphabeticallySorted == d->MenuInsertionOrder);
+	QMenu* Menu = d->viewMenuGroup(Group, GroupIcon);
+	d->addActionsToMenu(ToggleViewActions, Menu, AlphabeticallySorted);
+	d->ViewMenuModel->addActions(ToggleViewActions, Group);
+	return Group.isEmpty() ? nullptr : Menu->menuAction();
 }
 
 
@@ -1196,6 +2156,18 @@ CDockGroupMenu *CDockManager::groupMenu()
 }
 
 
+//============================================================================
+CViewMenuPopup* CDockManager::viewMenuPopup()
+{
+	if (!d->ViewMenuPopup)
+	{
+		d->ViewMenuPopup = new CViewMenuPopup(d->ViewMenuModel,
+			MenuAlphabeticallySorted == d->MenuInsertionOrder, this);
+	}
+	return d->ViewMenuPopup;
+}
+
+
 //============================================================================
 void CDockManager::setViewMenuInsertionOrder(eViewMenuInsertionOrder Order)
 {
@@ -1210,6 +2182,142 @@ bool CDockManager::isRestoringState() const
 }
 
 
+//===========================================================================
+void CDockManager::beginUpdate()
+{
+	// While the deferred side effects are executed, the repolish scheduler
+	// is still held by the outermost transaction
+	if (0 == d->UpdateDepth++ && !d->FlushingUpdates)
+	{
+		CRepolishScheduler::instance()->hold();
+	}
+}
+
+
+//===========================================================================
+void CDockManager::endUpdate()
+{
+	if (d->UpdateDepth <= 0)
+	{
+		qWarning("CDockManager::endUpdate() called without beginUpdate()");
+		return;
+	}
+
+	if (--d->UpdateDepth > 0 || d->FlushingUpdates)
+	{
+		return;
+	}
+
+	d->flushDeferredUpdates();
+	CRepolishScheduler::instance()->release();
+}
+
+
+//===========================================================================
+bool CDockManager::isUpdating() const
+{
+	return d->UpdateDepth > 0;
+}
+
+
+//===========================================================================
+int CDockManager::beginInteraction(const QList<CDockWidget*>& DockWidgets)
+{
+	// Id 0 is never returned, so callers can use it as "no interaction"
+	if (++d->LastInteractionId <= 0)
+	{
+		d->LastInteractionId = 1;
+	}
+	int InteractionId = d->LastInteractionId;
+	auto& Affected = d->Interactions[InteractionId];
+	for (auto DockWidget : DockWidgets)
+	{
+		Affected.append(DockWidget);
+	}
+
+	if (d->Interactions.count() == 1)
+	{
+		emit interactionStarted();
+	}
+	for (auto DockWidget : DockWidgets)
+	{
+		DockWidget->beginInteraction();
+	}
+	return InteractionId;
+}
+
+
+//===========================================================================
+void CDockManager::endInteraction(int InteractionId)
+{
+	auto it = d->Interactions.find(InteractionId);
+	if (it == d->Interactions.end())
+	{
+		return;
+	}
+
+	auto Affected = it.value();
+	d->Interactions.erase(it);
+	for (auto DockWidget : Affected)
+	{
+		if (DockWidget)
+		{
+			DockWidget->endInteraction();
+		}
+	}
+	if (d->Interactions.isEmpty())
+	{
+		emit interactionFinished();
+	}
+}
+
+
+//===========================================================================
+bool CDockManager::isInteractionActive() const
+{
+	return !d->Interactions.isEmpty();
+}
+
+
+//===========================================================================
+bool CDockManager::deferSplitterHandleUpdate(QSplitter* Splitter)
+{
+	if (!d->deferUpdates())
+	{
+		return false;
+	}
+
+	d->PendingSplitterHandleUpdates.insert(Splitter, Splitter);
+	return true;
+}
+
+
+//===========================================================================
+bool CDockManager::deferTopLevelUpdate(CDockContainerWidget* Container)
+{
+	if (!d->deferUpdates())
+	{
+		return false;
+	}
+
+	d->PendingTopLevelUpdates.insert(Container, Container);
+	return true;
+}
+
+
+//===========================================================================
+bool CDockManager::deferGroupMenuUpdate()
+{
+	if (!d->deferUpdates())
+	{
+		return false;
+	}
+
+	d->GroupMenusOutdated = true;
+	return true;
+}
+
+
 //===========================================================================
 int CDockManager::startDragDistance()
 {
@@ -1244,6 +2352,48 @@ bool CDockManager::testConfigFlag(eConfigFlag Flag)
 }
 
 
+//===========================================================================
+CDockManager::PerformanceFlags CDockManager::performanceFlags()
+{
+	return StaticPerformanceFlags;
+}
+
+
+//===========================================================================
+void CDockManager::setPerformanceFlags(const PerformanceFlags Flags)
+{
+	StaticPerformanceFlags = Flags;
+}
+
+
+//===========================================================================
+void CDockManager::setPerformanceFlag(ePerformanceFlag Flag, bool On)
+{
+	internal::setFlag(StaticPerformanceFlags, Flag, On);
+}
+
+
+//===========================================================================
+bool CDockManager::testPerformanceFlag(ePerformanceFlag Flag)
+{
+	return performanceFlags().testFlag(Flag);
+}
+
+
+//===========================================================================
+void CDockManager::setSplitterResizeInterval(int Milliseconds)
+{
+	StaticSplitterResizeInterval = qMax(0, Milliseconds);
+}
+
+
+//===========================================================================
+int CDockManager::splitterResizeInterval()
+{
+	return StaticSplitterResizeInterval;
+}
+
+
 //===========================================================================
 CIconProvider& CDockManager::iconProvider()
 {
@@ -1260,7 +2410,7 @@ void CDockManager::notifyWidgetOrAreaRelocation(QWidget* DroppedWidget)
 		d->FocusController->notifyWidgetOrAreaRelocation(DroppedWidget);
 	}
 
-    emit layoutChanged();
+    d->notifyLayoutChanged();
 }
 
 
@@ -1274,6 +2424,16 @@ void CDockManager::notifyFloatingWidgetDrop(CFloatingDockContainer* FloatingWidg
 }
 
 
+//===========================================================================
+void CDockManager::notifyDockWidgetContentChanged()
+{
+	if (d->FocusController)
+	{
+		d->FocusController->invalidateOwnerCache();
+	}
+}
+
+
 //===========================================================================
 void CDockManager::setDockWidgetFocused(CDockWidget* DockWidget)
 {
@@ -33,11 +33,13 @@
 #include "ads_globals.h"
 #include "DockContainerWidget.h"
 #include "DockWidget.h"
+#include "DockWidgetRegistry.h"
 #include "FloatingDockContainer.h"
 
 
 QT_FORWARD_DECLARE_CLASS(QSettings)
 QT_FORWARD_DECLARE_CLASS(QMenu)
+QT_FORWARD_DECLARE_CLASS(QPixmap)
 
 namespace ads
 {
@@ -54,6 +56,25 @@ struct DockAreaWidgetPrivate;
 class CIconProvider;
 class CDockComponentsFactory;
 class CDockGroupMenu;
+class CViewMenuPopup;
+class CDockLayout;
+
+
+/**
+ * Describes a single dock widget insertion for CDockManager::addDockWidgets()
+ */
+struct CDockWidgetInsertion
+{
+	CDockWidget* DockWidget = nullptr; ///< the dock widget to insert
+	DockWidgetArea Area = CenterDockWidgetArea; ///< area in the target area or in the container
+	CDockAreaWidget* TargetArea = nullptr; ///< the target dock area or nullptr
+	/**
+	 * Index of a previous insertion of the same bulk insertion. If it is
+	 * valid, the dock area of that insertion is used as target area. This
+	 * allows building nested layouts in one bulk insertion.
+	 */
+	int TargetInsertion = -1;
+};
 
 /**
  * The central dock manager that maintains the complete docking system.
@@ -84,6 +105,8 @@ private:
 	friend class CFloatingDragPreview;
 	friend struct FloatingDragPreviewPrivate;
 	friend class CDockAreaTitleBar;
+	friend class CDockWidget;
+	friend class CDockAreaWidget;
 
 
 protected:
@@ -99,6 +122,55 @@ protected:
 	 */
 	void removeFloatingWidget(CFloatingDockContainer* FloatingWidget);
 
+	/**
+	 * Takes an empty floating widget from the floating widget pool and
+	 * registers it. Returns a nullptr if the pool is empty
+	 */
+	CFloatingDockContainer* takePooledFloatingWidget();
+
+	/**
+	 * This function is called instead of deleteLater() each time a floating
+	 * widget becomes empty - if its dock areas have been dropped into
+	 * another container, its last dock widget has been dragged out or
+	 * closed or if it is not used by a restored state. The floating widget
+	 * is reset and put into the pool if the pool is not full. Otherwise it
+	 * is deleted
+	 */
+	void releaseFloatingWidget(CFloatingDockContainer* FloatingWidget);
+
+	/**
+	 * Takes an empty dock area from the dock area pool and moves it into
+	 * the given container. Returns a nullptr if the pool is empty
+	 */
+	CDockAreaWidget* takePooledDockArea(CDockContainerWidget* Container);
+
+	/**
+	 * Call this function instead of deleteLater() if the given dock area
+	 * has been removed from its container because it is empty. The dock area
+	 * is reset and put into the pool if the pool is not full. Otherwise it
+	 * is deleted
+	 */
+	void releaseDockArea(CDockAreaWidget* DockArea);
+
+	/**
+	 * Stores the content snapshot of the given widget in the least recently
+	 * used snapshot cache.
+	 * Dock areas with the CDockAreaWidget::ContentSnapshots flag call this
+	 * function if a tab is deactivated
+	 */
+	void cacheContentSnapshot(QWidget* Widget, const QPixmap& Pixmap);
+
+	/**
+	 * Returns the cached content snapshot of the given widget or a null
+	 * pixmap if there is no snapshot
+	 */
+	QPixmap contentSnapshot(QWidget* Widget) const;
+
+	/**
+	 * Removes the content snapshot of the given widget from the cache
+	 */
+	void removeContentSnapshot(QWidget* Widget);
+
 	/**
 	 * Registers the given dock container widget
 	 */
@@ -135,6 +207,41 @@ protected:
 	 */
 	void notifyFloatingWidgetDrop(CFloatingDockContainer* FloatingWidget);
 
+	/**
+	 * A dock widget calls this function if its content widget has been
+	 * set or taken to invalidate the cached focus widget ancestry
+	 */
+	void notifyDockWidgetContentChanged();
+
+	/**
+	 * A dock widget calls this function if its group name has been changed
+	 * to update the group index of the dock widget registry
+	 */
+	void onDockWidgetGroupChanged(CDockWidget* DockWidget);
+
+	/**
+	 * Defers the update of the splitter handles of the given splitter until
+	 * the outermost update transaction ends.
+	 * Returns false, if no transaction is active and the caller needs to
+	 * update the splitter handles immediately
+	 */
+	bool deferSplitterHandleUpdate(QSplitter* Splitter);
+
+	/**
+	 * Defers the update of the floating window title and the top level
+	 * state of the given container until the outermost update transaction
+	 * ends.
+	 * Returns false, if no transaction is active
+	 */
+	bool deferTopLevelUpdate(CDockContainerWidget* Container);
+
+	/**
+	 * Defers the group menu update of all dock areas until the outermost
+	 * update transaction ends.
+	 * Returns false, if no transaction is active
+	 */
+	bool deferGroupMenuUpdate();
+
 
 	/**
 	 * Show the floating widgets that has been created floating
@@ -192,6 +299,8 @@ public:
         FloatingContainerForceQWidgetTitleBar = 0x1000000,//!< Linux only ! Forces all FloatingContainer to use a QWidget based title bar.
 														 //!< If neither this nor FloatingContainerForceNativeTitleBar is set (the default) native titlebars are used except on known bad systems.
 														 //! Users can overwrite this by setting the environment variable ADS_UseNativeTitle to "1" or "0".
+        DockAreaHasSearchableTabsMenu = 0x2000000, //!< If this flag is set, the tabs menu button opens a searchable, model based popup instead of the tabs menu. Use this for dock areas with many tabs
+        ProxyStyleRendering = 0x4000000, //!< If this flag is set, the dock manager does not load its stylesheet and the widgets of the docking system use the CDockStyle proxy style that paints all components. The application style is not changed. State changes then only cause a repaint instead of a stylesheet repolish
 
         DefaultDockAreaButtons = DockAreaHasCloseButton
 							   | DockAreaHasUndockButton
@@ -214,6 +323,24 @@ public:
 	};
 	Q_DECLARE_FLAGS(ConfigFlags, eConfigFlag)
 
+	/**
+	 * These global performance flags enable optional optimizations of the
+	 * docking system. All optimizations are disabled by default.
+	 * Set the performance flags, before you create the dock manager instance.
+	 */
+	enum ePerformanceFlag
+	{
+		DeferredRepolish = 0x0001, //!< If this flag is set, stylesheet repolish requests are collected and executed once per event loop iteration by the CRepolishScheduler
+		LazyDockWidgetConstruction = 0x0002, //!< If this flag is set, the tab close button and the content scroll area of a dock widget are created when they are needed the first time
+		LazyDockWidgetTabCreation = 0x0004, //!< If this flag is set, the tab widget of a dock widget is created the first time it is requested via CDockWidget::tabWidget()
+		StackedDockAreaContent = 0x0008, //!< If this flag is set, the dock widgets of a dock area stay parented to the dock area and a tab switch only hides and shows them instead of reparenting them
+		FlatLayoutEngine = 0x0010, //!< If this flag is set, dock containers arrange their dock areas with a CDockFlatLayout that solves the whole split tree in one pass instead of nesting one CDockSplitter per split
+		SystemMoveFloatingWidgets = 0x0020, //!< Linux only ! If this flag is set, dragging a floating widget via its title bar is handed over to the window manager (_NET_WM_MOVERESIZE) and the drop overlays are updated by polling the cursor at frame rate. Requires Qt 5.15
+		LightweightFloatingWidgets = 0x0040, //!< If this flag is set, the dock area of a floating widget with a single dock widget is created without title bar and tab bar. They are created when a second dock widget or dock area is docked into the floating widget. Has no effect if AlwaysShowTabs or FocusHighlighting is set
+		DefaultPerformanceConfig = 0 ///< the default configuration with all optimizations disabled
+	};
+	Q_DECLARE_FLAGS(PerformanceFlags, ePerformanceFlag)
+
 	/**
 	 * Default Constructor.
 	 * If the given parent is a QMainWindow, the dock manager sets itself as the
@@ -251,6 +378,47 @@ public:
 	 */
 	static bool testConfigFlag(eConfigFlag Flag);
 
+	/**
+	 * This function returns the global performance flags
+	 */
+	static PerformanceFlags performanceFlags();
+
+	/**
+	 * Sets the global performance flags for the whole docking system.
+	 * Call this function before you create the dock manager and before
+	 * your create the first dock widget.
+	 */
+	static void setPerformanceFlags(const PerformanceFlags Flags);
+
+	/**
+	 * Set a certain performance flag.
+	 * \see setPerformanceFlags()
+	 */
+	static void setPerformanceFlag(ePerformanceFlag Flag, bool On = true);
+
+	/**
+	 * Returns true if the given performance flag is set
+	 */
+	static bool testPerformanceFlag(ePerformanceFlag Flag);
+
+	/**
+	 * Sets the minimum interval in milliseconds between two live updates
+	 * of a splitter handle drag. If the interval is greater than 0, the
+	 * splitters of new dock containers resize their content while the
+	 * handle is dragged, but not more often than once per interval. Use
+	 * 16 ms to update once per frame. The final position is always applied
+	 * when the handle is released. The default value 0 disables rate
+	 * limiting and the OpaqueSplitterResize flag defines the behavior.
+	 * Set the interval, before you create the dock manager instance.
+	 */
+	static void setSplitterResizeInterval(int Milliseconds);
+
+	/**
+	 * Returns the splitter resize interval
+	 * \see setSplitterResizeInterval()
+	 */
+	static int splitterResizeInterval();
+
 	/**
 	 * Returns the global icon provider.
 	 * The icon provider enables the use of custom icons in case using
@@ -297,6 +465,49 @@ public:
 	 */
     CFloatingDockContainer* addDockWidgetFloating(CDockWidget* Dockwidget, bool hide = false);
 
+	/**
+	 * Adds multiple dock widgets in one pass.
+	 * The dock widgets are inserted in the order of the given list. Each
+	 * insertion behaves like addDockWidget(). All insertions are executed in
+	 * one update transaction and splitter sizes are distributed only once.
+	 * Consecutive insertions into the center of the same target area are
+	 * added as tabs in one step.
+	 * \return Returns a list with the dock area of each insertion
+	 */
+	QList<CDockAreaWidget*> addDockWidgets(const QList<CDockWidgetInsertion>& Insertions);
+
+	/**
+	 * Adds all given dock widgets as tabs to the given area in one pass.
+	 * If no dock area widget exists for the given area identifier, a new
+	 * dock area widget is created.
+	 */
+	CDockAreaWidget* addDockWidgetsTab(DockWidgetArea area,
+		const QList<CDockWidget*>& DockWidgets);
+
+	/**
+	 * Adds all given dock widgets as tabs to the given DockAreaWidget in
+	 * one pass
+	 */
+	CDockAreaWidget* addDockWidgetsTabToArea(const QList<CDockWidget*>& DockWidgets,
+		CDockAreaWidget* DockAreaWidget);
+
+	/**
+	 * Constructs the given declarative layout in one pass.
+	 * The given dock widgets are registered in the dock manager. The layout
+	 * references dock widgets by object name, so it may also reference dock
+	 * widgets that are already registered. The splitters and dock areas are
+	 * created directly with their final structure and sizes, without
+	 * intermediate layouts. This function only works for a dock manager
+	 * that does not contain any dock areas yet, e.g. for a first-run
+	 * default layout. Given dock widgets that the layout does not reference
+	 * are closed and unassigned, like dock widgets that are missing in a
+	 * state restored with restoreState().
+	 * \return Returns false without changing the dock manager if it already
+	 * contains dock areas or if DockWidgets contains a null pointer
+	 */
+	bool buildLayout(const CDockLayout& Layout,
+		const QList<CDockWidget*>& DockWidgets = QList<CDockWidget*>());
+
 	/**
 	 * Searches for a registered doc widget with the given ObjectName
 	 * \return Return the found dock widget or nullptr if a dock widget with the
@@ -315,11 +526,20 @@ public:
     void renameDockWidget(CDockWidget* Dockwidget, const QString &name, const QString &objectName);
 
 	/**
-	 * This function returns a readable reference to the internal dock
-	 * widgets map so that it is possible to iterate over all dock widgets
+	 * This function returns a copy of the internal dock widgets registry
+	 * as a map from object name to dock widget.
+	 * Use dockWidgetRegistry() to iterate over all dock widgets without
+	 * copying.
 	 */
 	QMap<QString, CDockWidget*> dockWidgetsMap() const;
 
+	/**
+	 * Returns the registry of all dock widgets of this dock manager.
+	 * The registry provides hashed lookup by name and group and non
+	 * allocating iteration over all dock widgets.
+	 */
+	const CDockWidgetRegistry& dockWidgetRegistry() const;
+
 	/**
 	 * Returns the list of all active and visible dock containers
 	 * Dock containers are the main dock manager and all floating widgets
@@ -331,6 +551,55 @@ public:
 	 */
 	const QList<CFloatingDockContainer*> floatingWidgets() const;
 
+	/**
+	 * Sets the maximum number of hidden floating widgets that are kept for
+	 * reuse. Floating widgets whose content has been dropped into another
+	 * container are reset and put into the pool instead of being deleted.
+	 * New floating widgets are taken from the pool if it is not empty.
+	 * The default size is 0 which disables the pool
+	 */
+	void setFloatingWidgetPoolSize(int Size);
+
+	/**
+	 * Returns the maximum number of pooled floating widgets
+	 */
+	int floatingWidgetPoolSize() const;
+
+	/**
+	 * Creates hidden floating widgets including their native windows until
+	 * the pool is full. Call this function at application startup to
+	 * move the cost of the first floating widgets out of the first undock
+	 */
+	void prewarmFloatingWidgetPool();
+
+	/**
+	 * Sets the maximum number of empty dock areas that are kept for reuse.
+	 * Dock areas that become empty during drag and drop are reset and put
+	 * into the pool instead of being deleted. New dock areas are taken from
+	 * the pool if it is not empty. A reused dock area is reset to the state
+	 * of a new dock area and the dockAreaCreated() signal is emitted again.
+	 * The default size is 0 which disables the pool
+	 */
+	void setDockAreaPoolSize(int Size);
+
+	/**
+	 * Returns the maximum number of pooled dock areas
+	 */
+	int dockAreaPoolSize() const;
+
+	/**
+	 * Sets the memory budget in KBytes for the content snapshots of dock
+	 * areas with the CDockAreaWidget::ContentSnapshots flag. If the budget
+	 * is exceeded, the least recently used snapshots are dropped.
+	 * The default budget is 64 MBytes
+	 */
+	void setContentSnapshotCacheSize(int KBytes);
+
+	/**
+	 * Returns the memory budget in KBytes of the content snapshot cache
+	 */
+	int contentSnapshotCacheSize() const;
+
 	/**
 	 * This function always return 0 because the main window is always behind
 	 * any floating widget
@@ -459,6 +728,17 @@ public:
 	QAction* addToggleViewActionToMenu(QAction* ToggleViewAction,
 		const QString& Group = QString(), const QIcon& GroupIcon = QIcon());
 
+	/**
+	 * Adds all given toggle view actions to the view menu in one pass.
+	 * This function is much faster than calling addToggleViewActionToMenu()
+	 * for each action if many actions are added to an alphabetically sorted
+	 * menu.
+	 * \return If Group is not empty, this function returns the GroupAction
+	 *         for this group. Otherwise it returns a nullptr.
+	 */
+	QAction* addToggleViewActionsToMenu(const QList<QAction*>& ToggleViewActions,
+		const QString& Group = QString(), const QIcon& GroupIcon = QIcon());
+
 	/**
 	 * This function returns the internal view menu.
 	 * To fill the view menu, you can use the addToggleViewActionToMenu()
@@ -471,6 +751,14 @@ public:
      */
     CDockGroupMenu *groupMenu();
 
+	/**
+	 * Returns a filterable popup that lists all toggle view actions of the
+	 * view menu. The popup is created on the first call. Show it with
+	 * CViewMenuPopup::popup(), e.g. from a shortcut, if the view menu is too
+	 * large to browse
+	 */
+	CViewMenuPopup* viewMenuPopup();
+
 	/**
 	 * Define the insertion order for toggle view menu items.
 	 * The order defines how the actions are added to the view menu.
@@ -487,6 +775,56 @@ public:
 	 */
 	bool isRestoringState() const;
 
+	/**
+	 * Starts an update transaction.
+	 * Until the outermost transaction is finished by endUpdate(), the
+	 * side effects of adding, removing or moving dock widgets are
+	 * deferred: splitter handle updates, top level and floating title
+	 * updates, group menu updates, focus style repolishing, the
+	 * dockWidgetAdded() signal and the layoutChanged() signal. A dock widget
+	 * that is added and removed again in the same transaction is not
+	 * reported at all. The signals of removed dock widgets are not
+	 * deferred, because a removed dock widget may be deleted right after
+	 * its removal. Transactions may be nested.
+	 * Use CDockManagerUpdateGuard to ensure that each beginUpdate() is
+	 * paired with an endUpdate().
+	 */
+	void beginUpdate();
+
+	/**
+	 * Finishes an update transaction.
+	 * If this is the outermost transaction, all deferred side effects are
+	 * executed once and the batched signal dockWidgetsAdded() is emitted
+	 */
+	void endUpdate();
+
+	/**
+	 * Returns true, if an update transaction is active
+	 */
+	bool isUpdating() const;
+
+	/**
+	 * Starts an interactive operation like a splitter drag, a floating
+	 * widget resize, an undock drag or a state restore that affects the
+	 * given dock widgets. The function emits interactionStarted() if no
+	 * other interaction is active and CDockWidget::interactionStarted() for
+	 * each dock widget that is not part of another active interaction.
+	 * Returns the id that needs to be passed to endInteraction()
+	 */
+	int beginInteraction(const QList<CDockWidget*>& DockWidgets);
+
+	/**
+	 * Finishes the interaction with the given id.
+	 * Interactions are reference counted, so interactionFinished() is
+	 * emitted when the last active interaction finishes
+	 */
+	void endInteraction(int InteractionId);
+
+	/**
+	 * Returns true, if an interactive operation is active
+	 */
+	bool isInteractionActive() const;
+
 	/**
 	 * The distance the user needs to move the mouse with the left button
 	 * hold down before a dock widget start floating
@@ -585,6 +923,9 @@ signals:
      * This signal is emitted, if a new DockArea has been created.
      * An application can use this signal to set custom icons or custom
      * tooltips for the DockArea buttons.
+     * If dock areas are pooled, the signal is also emitted each time a
+     * pooled dock area is reused.
+     * \see setDockAreaPoolSize()
      */
     void dockAreaCreated(ads::CDockAreaWidget* DockArea);
 
@@ -594,6 +935,13 @@ signals:
      */
     void dockWidgetAdded(CDockWidget* DockWidget);
 
+    /**
+     * This signal is emitted with all dock widgets that have been added
+     * during an update transaction when the transaction ends. Outside of
+     * a transaction, it is emitted for each added dock widget.
+     */
+    void dockWidgetsAdded(const QList<ads::CDockWidget*>& DockWidgets);
+
     /**
      * This signal is emitted, if a DockWidget renamed
      * An DockAreaWidget use this signal to update group add menu
@@ -627,7 +975,56 @@ signals:
      * The focused dock widget is the one that is highlighted in the GUI
      */
     void focusedDockWidgetChanged(ads::CDockWidget* old, ads::CDockWidget* now);
+
+    /**
+     * This signal is emitted if the first of possibly nested interactive
+     * operations starts. Content widgets may switch to a cheap rendering
+     * mode until interactionFinished() is emitted
+     */
+    void interactionStarted();
+
+    /**
+     * This signal is emitted if the last active interactive operation
+     * finished
+     */
+    void interactionFinished();
 }; // class DockManager
+
+
+/**
+ * Scope guard for an update transaction of a dock manager.
+ * The constructor calls CDockManager::beginUpdate() and the destructor
+ * calls CDockManager::endUpdate().
+ * \code
+ * {
+ *     CDockManagerUpdateGuard Guard(DockManager);
+ *     for (auto DockWidget : DockWidgets)
+ *     {
+ *         DockManager->addDockWidget(RightDockWidgetArea, DockWidget);
+ *     }
+ * } // all deferred side effects are executed here
+ * \endcode
+ */
+class ADS_EXPORT CDockManagerUpdateGuard
+{
+private:
+	CDockManager* DockManager;
+
+public:
+	explicit CDockManagerUpdateGuard(CDockManager* DockManager) :
+		DockManager(DockManager)
+	{
+		DockManager->beginUpdate();
+	}
+
+	~CDockManagerUpdateGuard()
+	{
+		DockManager->endUpdate();
+	}
+
+	CDockManagerUpdateGuard(const CDockManagerUpdateGuard&) = delete;
+	CDockManagerUpdateGuard& operator=(const CDockManagerUpdateGuard&) = delete;
+}; // class CDockManagerUpdateGuard
 } // namespace ads
 //-----------------------------------------------------------------------------
 #endif // DockManagerH
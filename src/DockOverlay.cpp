@@ -388,7 +388,7 @@ DockWidgetArea CDockOverlay::dropAreaUnderCursor() const
 	}
 
 	if (DockArea->allowedAreas().testFlag(CenterDockWidgetArea)
-	 && !DockArea->titleBar()->isHidden()
+	 && DockArea->hasTitleBar() && !DockArea->titleBar()->isHidden()
 	 && DockArea->titleBarGeometry().contains(DockArea->mapFromGlobal(QCursor::pos())))
 	{
 		return CenterDockWidgetArea;
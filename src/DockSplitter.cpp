@@ -31,8 +31,14 @@
 
 #include <QDebug>
 #include <QChildEvent>
+#include <QMouseEvent>
+#include <QPointer>
+#include <QTimer>
 
 #include "DockAreaWidget.h"
+#include "DockManager.h"
+#include "DockStyle.h"
+#include "DockWidget.h"
 
 namespace ads
 {
@@ -43,10 +49,208 @@ struct DockSplitterPrivate
 {
 	CDockSplitter* _this;
 	int VisibleContentCount = 0;
+	QPointer<CDockManager> InteractionManager;
+	int InteractionId = 0;
+	int OpaqueResizeInterval = 0;
 
 	DockSplitterPrivate(CDockSplitter* _public) : _this(_public) {}
+
+	/**
+	 * Appends the current dock widgets of all visible dock areas in the
+	 * splitter tree to the given list
+	 */
+	void appendVisibleDockWidgets(QList<CDockWidget*>& DockWidgets) const;
+
+	/**
+	 * Starts the interaction for a handle drag
+	 */
+	void beginHandleDrag();
+
+	/**
+	 * Finishes the interaction of a handle drag
+	 */
+	void endHandleDrag();
 };
 
+
+//============================================================================
+void DockSplitterPrivate::appendVisibleDockWidgets(QList<CDockWidget*>& DockWidgets) const
+{
+	for (int i = 0; i < _this->count(); ++i)
+	{
+		auto Widget = _this->widget(i);
+		if (Widget->isHidden())
+		{
+			continue;
+		}
+
+		auto Area = qobject_cast<CDockAreaWidget*>(Widget);
+		if (Area && Area->currentDockWidget())
+		{
+			DockWidgets.append(Area->currentDockWidget());
+			continue;
+		}
+
+		auto Splitter = qobject_cast<CDockSplitter*>(Widget);
+		if (Splitter)
+		{
+			Splitter->d->appendVisibleDockWidgets(DockWidgets);
+		}
+	}
+}
+
+
+//============================================================================
+void DockSplitterPrivate::beginHandleDrag()
+{
+	if (InteractionId)
+	{
+		return;
+	}
+
+	QList<CDockWidget*> DockWidgets;
+	appendVisibleDockWidgets(DockWidgets);
+	if (DockWidgets.isEmpty() || !DockWidgets.first()->dockManager())
+	{
+		return;
+	}
+
+	InteractionManager = DockWidgets.first()->dockManager();
+	InteractionId = InteractionManager->beginInteraction(DockWidgets);
+}
+
+
+//============================================================================
+void DockSplitterPrivate::endHandleDrag()
+{
+	if (InteractionManager)
+	{
+		InteractionManager->endInteraction(InteractionId);
+	}
+	InteractionManager = nullptr;
+	InteractionId = 0;
+}
+
+/**
+ * Splitter handle that applies live resizes at a limited rate if the
+ * opaque resize interval of its splitter is greater than 0
+ */
+class CDockSplitterHandle : public QSplitterHandle
+{
+private:
+	QTimer m_ResizeTimer;
+	int m_PendingPos = 0;
+	bool m_HasPendingPos = false;
+	int m_MouseOffset = 0;
+
+	int pick(const QPoint& Pos) const
+	{
+		return (orientation() == Qt::Horizontal) ? Pos.x() : Pos.y();
+	}
+
+	/**
+	 * Returns the splitter position for the given mouse event exactly like
+	 * QSplitterHandle::mouseMoveEvent() does. The position is not mirrored
+	 * for right-to-left layouts because moveSplitter() already does this
+	 */
+	int splitterPos(QMouseEvent* e) const
+	{
+		return pick(parentWidget()->mapFromGlobal(e->globalPos())) - m_MouseOffset;
+	}
+
+	/**
+	 * Stores the position that is applied by the next applyPendingPos() call
+	 */
+	void setPendingPos(int Pos)
+	{
+		m_PendingPos = Pos;
+		m_HasPendingPos = true;
+	}
+
+	int resizeInterval() const
+	{
+		return static_cast<CDockSplitter*>(splitter())->opaqueResizeInterval();
+	}
+
+	/**
+	 * Moves the splitter to the pending position and restarts the timer to
+	 * delay the next move
+	 */
+	void applyPendingPos()
+	{
+		if (!m_HasPendingPos)
+		{
+			return;
+		}
+
+		m_HasPendingPos = false;
+		moveSplitter(m_PendingPos);
+		m_ResizeTimer.start(resizeInterval());
+	}
+
+public:
+	using Super = QSplitterHandle;
+
+	CDockSplitterHandle(Qt::Orientation Orientation, CDockSplitter* Parent)
+		: QSplitterHandle(Orientation, Parent)
+	{
+		m_ResizeTimer.setSingleShot(true);
+		connect(&m_ResizeTimer, &QTimer::timeout, this, [this]() { applyPendingPos(); });
+	}
+
+protected:
+	virtual void mousePressEvent(QMouseEvent* e) override
+	{
+		Super::mousePressEvent(e);
+		if (e->button() == Qt::LeftButton)
+		{
+			m_MouseOffset = pick(e->pos());
+		}
+	}
+
+	virtual void mouseMoveEvent(QMouseEvent* e) override
+	{
+		// Without opaque resize, QSplitterHandle only moves the rubber band
+		if (resizeInterval() <= 0 || !opaqueResize())
+		{
+			Super::mouseMoveEvent(e);
+			return;
+		}
+
+		if (!(e->buttons() & Qt::LeftButton))
+		{
+			return;
+		}
+
+		// The first move is applied immediately, all further moves within
+		// the interval are collapsed into one move when the timer expires
+		setPendingPos(splitterPos(e));
+		if (!m_ResizeTimer.isActive())
+		{
+			applyPendingPos();
+		}
+	}
+
+	virtual void mouseReleaseEvent(QMouseEvent* e) override
+	{
+		if (resizeInterval() > 0 && e->button() == Qt::LeftButton)
+		{
+			m_ResizeTimer.stop();
+			// Without opaque resize, QSplitterHandle commits the final
+			// position itself
+			if (opaqueResize())
+			{
+				setPendingPos(splitterPos(e));
+				applyPendingPos();
+				m_ResizeTimer.stop();
+			}
+			m_HasPendingPos = false;
+		}
+		Super::mouseReleaseEvent(e);
+	}
+};
+
+
 //============================================================================
 CDockSplitter::CDockSplitter(QWidget *parent)
 	: QSplitter(parent),
@@ -54,6 +258,7 @@ CDockSplitter::CDockSplitter(QWidget *parent)
 {
 	setProperty("ads-splitter", true);
 	setChildrenCollapsible(false);
+	CDockStyle::applyTo(this);
 }
 
 
@@ -63,12 +268,14 @@ CDockSplitter::CDockSplitter(Qt::Orientation orientation, QWidget *parent)
 	  d(new DockSplitterPrivate(this))
 {
     setHandleWidth(2);
+	CDockStyle::applyTo(this);
 }
 
 //============================================================================
 CDockSplitter::~CDockSplitter()
 {
     ADS_PRINT("~CDockSplitter");
+	d->endHandleDrag();
 	delete d;
 }
 
@@ -105,15 +312,75 @@ QWidget* CDockSplitter::lastWidget() const
 //============================================================================
 bool CDockSplitter::isResizingWithContainer() const
 {
-    for (auto area : findChildren<CDockAreaWidget*>())
-    {
-        if(area->isCentralWidgetArea())
-        {
-            return true;
-        }
-    }
+	// Only the splitter tree is searched - the content widgets of the dock
+	// areas are never visited
+	for (int i = 0; i < count(); ++i)
+	{
+		auto Widget = widget(i);
+		auto Area = qobject_cast<CDockAreaWidget*>(Widget);
+		if (Area && Area->isCentralWidgetArea())
+		{
+			return true;
+		}
+
+		auto Splitter = qobject_cast<CDockSplitter*>(Widget);
+		if (Splitter && Splitter->isResizingWithContainer())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+//============================================================================
+QSplitterHandle* CDockSplitter::createHandle()
+{
+	auto Handle = new CDockSplitterHandle(orientation(), this);
+	Handle->installEventFilter(this);
+	return Handle;
+}
+
+
+//============================================================================
+void CDockSplitter::setOpaqueResizeInterval(int Milliseconds)
+{
+	d->OpaqueResizeInterval = qMax(0, Milliseconds);
+}
+
+
+//============================================================================
+int CDockSplitter::opaqueResizeInterval() const
+{
+	return d->OpaqueResizeInterval;
+}
+
+
+//============================================================================
+bool CDockSplitter::eventFilter(QObject* watched, QEvent* event)
+{
+	switch (event->type())
+	{
+	case QEvent::MouseButtonPress:
+		 if (static_cast<QMouseEvent*>(event)->button() == Qt::LeftButton)
+		 {
+			 d->beginHandleDrag();
+		 }
+		 break;
+
+	case QEvent::MouseButtonRelease:
+		 if (static_cast<QMouseEvent*>(event)->button() == Qt::LeftButton)
+		 {
+			 d->endHandleDrag();
+		 }
+		 break;
+
+	default:
+		break;
+	}
 
-    return false;
+	return Super::eventFilter(watched, event);
 }
 
 } // namespace ads
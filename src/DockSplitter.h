@@ -48,7 +48,21 @@ private:
 	DockSplitterPrivate* d;
 	friend struct DockSplitterPrivate;
 
+protected:
+	/**
+	 * Installs an event filter on each new handle to report handle drags
+	 * as interactions to the dock manager
+	 */
+	virtual QSplitterHandle* createHandle() override;
+
+	/**
+	 * Starts an interaction on handle press and finishes it on release
+	 */
+	virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
 public:
+	using Super = QSplitter;
+
 	CDockSplitter(QWidget *parent = Q_NULLPTR);
 	CDockSplitter(Qt::Orientation orientation, QWidget *parent = Q_NULLPTR);
 
@@ -76,6 +90,20 @@ public:
      * Returns true if the splitter contains central widget of dock manager.
      */
     bool isResizingWithContainer() const;
+
+	/**
+	 * Sets the minimum interval in milliseconds between two live resizes
+	 * while a handle is dragged. If the interval is greater than 0, the
+	 * content is resized during the drag independent of opaqueResize(),
+	 * but at most once per interval. The final position is always applied
+	 * on release. An interval of 0 restores the QSplitter behavior
+	 */
+	void setOpaqueResizeInterval(int Milliseconds);
+
+	/**
+	 * Returns the opaque resize interval
+	 */
+	int opaqueResizeInterval() const;
 }; // class CDockSplitter
 
 } // namespace ads
@@ -0,0 +1,347 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockStyle.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CDockStyle class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockStyle.h"
+
+#include <QApplication>
+#include <QPainter>
+#include <QLabel>
+#include <QStyleOption>
+#include <QToolButton>
+
+#include "DockAreaTitleBar.h"
+#include "DockAreaWidget.h"
+#include "DockContainerWidget.h"
+#include "DockFlatLayout.h"
+#include "DockManager.h"
+#include "DockSplitter.h"
+#include "DockWidget.h"
+#include "DockWidgetTab.h"
+
+#ifdef Q_OS_LINUX
+#include "linux/FloatingWidgetTitleBar.h"
+#endif
+
+namespace ads
+{
+/**
+ * Returns the given color with the given alpha value
+ */
+static QColor withAlpha(QColor Color, int Alpha)
+{
+	Color.setAlpha(Alpha);
+	return Color;
+}
+
+
+//============================================================================
+static bool isFocused(const QWidget* Widget)
+{
+	return Widget && Widget->property("focused").toBool();
+}
+
+
+//============================================================================
+static bool paintsStyledBackground(const QWidget* Widget)
+{
+	return qobject_cast<const CDockWidgetTab*>(Widget)
+		|| qobject_cast<const CDockAreaTitleBar*>(Widget)
+		|| qobject_cast<const CDockAreaWidget*>(Widget)
+		|| qobject_cast<const CDockContainerWidget*>(Widget)
+		|| qobject_cast<const CDockWidget*>(Widget)
+#ifdef Q_OS_LINUX
+		|| qobject_cast<const CFloatingWidgetTitleBar*>(Widget)
+#endif
+		|| Widget->objectName() == QLatin1String("tabsContainerWidget")
+		|| Widget->objectName() == QLatin1String("buttonsContainer");
+}
+
+
+//============================================================================
+CDockStyle::CDockStyle(QStyle* Style) :
+	Super(Style)
+{
+
+}
+
+
+//============================================================================
+CDockStyle* CDockStyle::instance()
+{
+	auto AppStyle = QApplication::style();
+	auto DockStyle = qobject_cast<CDockStyle*>(AppStyle);
+	if (DockStyle)
+	{
+		return DockStyle;
+	}
+
+	DockStyle = AppStyle->findChild<CDockStyle*>(QString(), Qt::FindDirectChildrenOnly);
+	if (!DockStyle)
+	{
+		// QProxyStyle makes itself the parent of its base style. The
+		// application style keeps its parent - so QApplication still deletes
+		// it if the application style changes - and owns the proxy instead
+		auto Parent = AppStyle->parent();
+		DockStyle = new CDockStyle(AppStyle);
+		AppStyle->setParent(Parent);
+		DockStyle->setParent(AppStyle);
+	}
+	return DockStyle;
+}
+
+
+//============================================================================
+void CDockStyle::applyTo(QWidget* Widget, bool Recursive)
+{
+	if (!CDockManager::testConfigFlag(CDockManager::ProxyStyleRendering))
+	{
+		return;
+	}
+
+	auto DockStyle = instance();
+	Widget->setStyle(DockStyle);
+	if (!Recursive)
+	{
+		return;
+	}
+
+	for (auto Child : Widget->findChildren<QWidget*>())
+	{
+		Child->setStyle(DockStyle);
+	}
+}
+
+
+//============================================================================
+bool CDockStyle::isDockButton(const QWidget* Widget)
+{
+	if (!Widget)
+	{
+		return false;
+	}
+
+	const auto& Name = Widget->objectName();
+	return Name == QLatin1String("tabCloseButton")
+		|| Name == QLatin1String("tabsMenuButton")
+		|| Name == QLatin1String("tabsGroupButton")
+		|| Name == QLatin1String("detachGroupButton")
+		|| Name == QLatin1String("dockAreaCloseButton")
+		|| Name == QLatin1String("floatingTitleCloseButton")
+		|| Name == QLatin1String("floatingTitleMaximizeButton");
+}
+
+
+//============================================================================
+void CDockStyle::updateWidgetState(QWidget* Widget)
+{
+	// The tab label uses the light palette color if the tab is focused.
+	// Changing the palette only causes a repaint of the label
+	auto Tab = qobject_cast<CDockWidgetTab*>(Widget);
+	if (Tab)
+	{
+		for (auto Label : Tab->findChildren<QLabel*>(QString(), Qt::FindDirectChildrenOnly))
+		{
+			QPalette Palette = Tab->palette();
+			if (isFocused(Tab))
+			{
+				Palette.setColor(QPalette::WindowText, Palette.color(QPalette::Light));
+			}
+			Label->setPalette(Palette);
+		}
+	}
+
+	Widget->update();
+}
+
+
+//============================================================================
+void CDockStyle::polish(QWidget* Widget)
+{
+	Super::polish(Widget);
+	if (paintsStyledBackground(Widget))
+	{
+		// Ensures that QWidget paints the PE_Widget primitive before the
+		// widget itself is painted
+		Widget->setAttribute(Qt::WA_StyledBackground, true);
+	}
+}
+
+
+//============================================================================
+void CDockStyle::unpolish(QWidget* Widget)
+{
+	if (paintsStyledBackground(Widget))
+	{
+		Widget->setAttribute(Qt::WA_StyledBackground, false);
+	}
+	Super::unpolish(Widget);
+}
+
+
+//============================================================================
+void CDockStyle::drawPrimitive(PrimitiveElement Element, const QStyleOption* Option,
+	QPainter* Painter, const QWidget* Widget) const
+{
+	if (!Widget)
+	{
+		Super::drawPrimitive(Element, Option, Painter, Widget);
+		return;
+	}
+
+	const auto& Palette = Option->palette;
+	const auto& Rect = Option->rect;
+	if (PE_Widget == Element)
+	{
+		if (auto Tab = qobject_cast<const CDockWidgetTab*>(Widget))
+		{
+			if (isFocused(Tab))
+			{
+				Painter->fillRect(Rect, Palette.highlight());
+			}
+			else if (Tab->isActiveTab())
+			{
+				Painter->fillRect(Rect, Palette.window());
+			}
+			else
+			{
+				// Inactive tabs leave a one pixel gap at the bottom
+				Painter->fillRect(Rect.adjusted(0, 0, 0, -1), Palette.alternateBase());
+			}
+			return;
+		}
+
+		if (auto DockWidget = qobject_cast<const CDockWidget*>(Widget))
+		{
+			// Light background with a one pixel border in the window color
+			Painter->fillRect(Rect, Palette.window());
+			Painter->fillRect(Rect.adjusted(1, 1, -1, -1), Palette.light());
+			if (CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+			{
+				Painter->fillRect(QRect(Rect.topLeft(), QSize(Rect.width(), 2)),
+					isFocused(DockWidget) ? Palette.highlight() : Palette.window());
+			}
+			return;
+		}
+
+#ifdef Q_OS_LINUX
+		if (auto TitleBar = qobject_cast<const CFloatingWidgetTitleBar*>(Widget))
+		{
+			Painter->fillRect(Rect, isFocused(TitleBar) ? Palette.highlight() : Palette.window());
+			return;
+		}
+#endif
+
+		if (Widget->objectName() == QLatin1String("buttonsContainer"))
+		{
+			Painter->fillRect(Rect.adjusted(1, 0, 0, -1), Palette.alternateBase());
+			return;
+		}
+
+		if (qobject_cast<const CDockAreaWidget*>(Widget)
+		 && CDockManager::testConfigFlag(CDockManager::FocusHighlighting))
+		{
+			// the dock area is transparent in focus highlighting mode
+			return;
+		}
+
+		if (paintsStyledBackground(Widget))
+		{
+			Painter->fillRect(Rect, Palette.dark());
+			return;
+		}
+	}
+
+	if (PE_PanelButtonTool == Element && isDockButton(Widget))
+	{
+		// Flat buttons that are highlighted only on hover and if pressed.
+		// On a focused tab, the highlighted text color is used because the
+		// tab is painted in the highlight color
+		bool FocusedTab = isFocused(Widget->parentWidget());
+		if (Option->state & State_Sunken)
+		{
+			Painter->fillRect(Rect, FocusedTab
+				? withAlpha(Palette.color(QPalette::HighlightedText), 92)
+				: withAlpha(Palette.color(QPalette::Shadow), 32));
+		}
+		else if ((Option->state & State_MouseOver) && (Option->state & State_Enabled))
+		{
+			Painter->fillRect(Rect, FocusedTab
+				? withAlpha(Palette.color(QPalette::HighlightedText), 48)
+				: Palette.midlight());
+		}
+		return;
+	}
+
+	if (PE_FrameButtonTool == Element && isDockButton(Widget))
+	{
+		return;
+	}
+
+	Super::drawPrimitive(Element, Option, Painter, Widget);
+}
+
+
+//============================================================================
+void CDockStyle::drawControl(ControlElement Element, const QStyleOption* Option,
+	QPainter* Painter, const QWidget* Widget) const
+{
+	// QSplitterHandle passes the splitter as widget
+	if (CE_Splitter == Element && Widget
+	 && (qobject_cast<const CDockSplitter*>(Widget)
+	  || qobject_cast<const CDockSplitter*>(Widget->parentWidget())
+	  || qobject_cast<const CDockFlatLayoutWidget*>(Widget)))
+	{
+		Painter->fillRect(Option->rect, Option->palette.dark());
+		return;
+	}
+
+	Super::drawControl(Element, Option, Painter, Widget);
+}
+
+
+//============================================================================
+void CDockStyle::drawComplexControl(ComplexControl Control,
+	const QStyleOptionComplex* Option, QPainter* Painter, const QWidget* Widget) const
+{
+	auto ToolButtonOption = qstyleoption_cast<const QStyleOptionToolButton*>(Option);
+	if (CC_ToolButton == Control && ToolButtonOption && isDockButton(Widget))
+	{
+		// The dock buttons show their popup menus without a menu indicator
+		QStyleOptionToolButton ButtonOption(*ToolButtonOption);
+		ButtonOption.features &= ~QStyleOptionToolButton::HasMenu;
+		Super::drawComplexControl(Control, &ButtonOption, Painter, Widget);
+		return;
+	}
+
+	Super::drawComplexControl(Control, Option, Painter, Widget);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockStyle.cpp
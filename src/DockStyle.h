@@ -0,0 +1,109 @@
+#ifndef DockStyleH
+#define DockStyleH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockStyle.h
+/// \date   18.10.2026
+/// \brief  Declaration of CDockStyle class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QProxyStyle>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+/**
+ * Proxy style that renders the docking system components without a
+ * stylesheet.
+ * The style paints the backgrounds of tabs, title bars, dock widgets and
+ * dock areas, the title bar buttons and the splitter handles from the widget
+ * palette and from the current widget state (active tab, focus highlighting).
+ * Because the state is read while painting, a state change only requires a
+ * repaint of the widget and no stylesheet unpolish / polish.
+ * If the CDockManager::ProxyStyleRendering flag is set, the widgets of the
+ * docking system set this style via applyTo(). The application style is not
+ * changed and the content widgets of the dock widgets keep their style.
+ */
+class ADS_EXPORT CDockStyle : public QProxyStyle
+{
+	Q_OBJECT
+public:
+	using Super = QProxyStyle;
+
+	/**
+	 * Creates the style as a proxy for the given base style.
+	 * The style takes ownership of the base style
+	 */
+	CDockStyle(QStyle* Style = nullptr);
+
+	/**
+	 * Returns the dock style that wraps the current application style.
+	 * The dock style is a child of the application style object, so it
+	 * lives as long as the style it wraps.
+	 */
+	static CDockStyle* instance();
+
+	/**
+	 * Sets the dock style for the given widget, if the
+	 * CDockManager::ProxyStyleRendering flag is set. If Recursive is true,
+	 * the style is also set for all child widgets.
+	 * QWidget::setStyle() does not propagate the style to child widgets, so
+	 * each widget of the docking system calls this function for itself.
+	 */
+	static void applyTo(QWidget* Widget, bool Recursive = false);
+
+	/**
+	 * Updates the palettes that depend on the given widgets state and
+	 * schedules a repaint.
+	 * This function replaces the stylesheet repolish in
+	 * internal::repolishStyle() if this style is active
+	 */
+	void updateWidgetState(QWidget* Widget);
+
+	/**
+	 * Returns true if the given widget is one of the title bar or tab
+	 * buttons of the docking system
+	 */
+	static bool isDockButton(const QWidget* Widget);
+
+public: // reimplements QProxyStyle -------------------------------------------
+	virtual void polish(QWidget* Widget) override;
+	using Super::polish;
+	virtual void unpolish(QWidget* Widget) override;
+	using Super::unpolish;
+
+	virtual void drawPrimitive(PrimitiveElement Element, const QStyleOption* Option,
+		QPainter* Painter, const QWidget* Widget = nullptr) const override;
+	virtual void drawControl(ControlElement Element, const QStyleOption* Option,
+		QPainter* Painter, const QWidget* Widget = nullptr) const override;
+	virtual void drawComplexControl(ComplexControl Control,
+		const QStyleOptionComplex* Option, QPainter* Painter,
+		const QWidget* Widget = nullptr) const override;
+}; // class CDockStyle
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // DockStyleH
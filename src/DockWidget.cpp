@@ -56,6 +56,7 @@
 #include "FloatingDockContainer.h"
 #include "DockSplitter.h"
 #include "DockComponentsFactory.h"
+#include "DockStyle.h"
 #include "ads_globals.h"
 
 #define RE_LOG_ENABLE
@@ -91,6 +92,12 @@ struct DockWidgetPrivate
 	QList<QAction*> TitleBarActions;
 	CDockWidget::eMinimumSizeHintMode MinimumSizeHintMode = CDockWidget::MinimumSizeHintFromDockWidget;
     QString GroupName;
+	QIcon Icon;
+	bool ScrollAreaDeferred = false;
+	bool RestoreDirty = false;
+	bool RestoreClosed = false;
+	int InteractionDepth = 0;
+	mutable QSize MinimumSizeHint; ///< cached minimum size hint of the content
 
 	/**
 	 * Private data constructor
@@ -107,6 +114,13 @@ struct DockWidgetPrivate
 	 */
 	void hideDockWidget();
 
+	/**
+	 * Shows the tab widget if it is in the tab bar of the dock area.
+	 * If the dock area has no title bar yet, the tab stays hidden until
+	 * the title bar is created
+	 */
+	void showTabWidget();
+
 	/**
 	 * Hides a dock area if all dock widgets in the area are closed.
 	 * This function updates the current selected tab and hides the parent
@@ -123,6 +137,23 @@ struct DockWidgetPrivate
 	 * Setup the main scroll area
 	 */
 	void setupScrollArea();
+
+	/**
+	 * Moves the content widget into the main scroll area if the creation
+	 * of the scroll area has been deferred
+	 */
+	void createDeferredScrollArea();
+
+	/**
+	 * Returns the tab widget and creates it, if it does not exist yet
+	 */
+	CDockWidgetTab* tabWidget();
+
+	/**
+	 * Invalidates the cached minimum size hint. If the hint has changed,
+	 * the parent dock area updates its own minimum size hint
+	 */
+	void updateMinimumSizeHint();
 };
 // struct DockWidgetPrivate
 
@@ -140,35 +171,33 @@ void DockWidgetPrivate::showDockWidget()
 	if (!DockArea)
 	{
         RE_LOG_DEBUG("No dock area");
-		CFloatingDockContainer* FloatingWidget = new CFloatingDockContainer(_this);
+		CFloatingDockContainer* FloatingWidget = CFloatingDockContainer::createFloatingWidget(_this);
 		FloatingWidget->resize(_this->size());
-		TabWidget->show();
+		showTabWidget();
 		FloatingWidget->show();
         if(DockArea) {
             RE_LOG_DEBUG("open dock area");
             DockArea->setCurrentDockWidget(_this);
             DockArea->toggleView(true);
-            TabWidget->show();
+            showTabWidget();
         }
 	}
 	else
 	{
 		DockArea->setCurrentDockWidget(_this);
 		DockArea->toggleView(true);
-		TabWidget->show();
-		QSplitter* Splitter = internal::findParent<QSplitter*>(DockArea);
+		showTabWidget();
+		QSplitter* Splitter = internal::parentSplitter<QSplitter*>(DockArea);
 		while (Splitter && !Splitter->isVisible())
 		{
 			Splitter->show();
-			Splitter = internal::findParent<QSplitter*>(Splitter);
+			Splitter = internal::parentSplitter<QSplitter*>(Splitter);
 		}
 
 		CDockContainerWidget* Container = DockArea->dockContainer();
 		if (Container->isFloating())
 		{
-			CFloatingDockContainer* FloatingWidget = internal::findParent<
-					CFloatingDockContainer*>(Container);
-			FloatingWidget->show();
+			Container->floatingWidget()->show();
 		}
 	}
 }
@@ -177,11 +206,23 @@ void DockWidgetPrivate::showDockWidget()
 //============================================================================
 void DockWidgetPrivate::hideDockWidget()
 {
-	TabWidget->hide();
+	tabWidget()->hide();
 	updateParentDockArea();
 }
 
 
+//============================================================================
+void DockWidgetPrivate::showTabWidget()
+{
+	if (DockArea && !DockArea->hasTitleBar())
+	{
+		return;
+	}
+
+	tabWidget()->show();
+}
+
+
 //============================================================================
 void DockWidgetPrivate::updateParentDockArea()
 {
@@ -208,6 +249,18 @@ void DockWidgetPrivate::updateParentDockArea()
 }
 
 
+//============================================================================
+void DockWidgetPrivate::updateMinimumSizeHint()
+{
+	auto OldSizeHint = MinimumSizeHint;
+	MinimumSizeHint = QSize();
+	if (DockArea && _this->minimumSizeHint() != OldSizeHint)
+	{
+		DockArea->updateMinimumSizeHint();
+	}
+}
+
+
 //============================================================================
 void DockWidgetPrivate::setupToolBar()
 {
@@ -232,6 +285,41 @@ void DockWidgetPrivate::setupScrollArea()
 }
 
 
+//============================================================================
+void DockWidgetPrivate::createDeferredScrollArea()
+{
+	if (!ScrollAreaDeferred)
+	{
+		return;
+	}
+
+	ScrollAreaDeferred = false;
+	setupScrollArea();
+	ScrollArea->setWidget(Widget);
+}
+
+
+//============================================================================
+CDockWidgetTab* DockWidgetPrivate::tabWidget()
+{
+	if (!TabWidget)
+	{
+		TabWidget = componentsFactory()->createDockWidgetTab(_this);
+		if (!Icon.isNull())
+		{
+			TabWidget->setIcon(Icon);
+		}
+#ifndef QT_NO_TOOLTIP
+		if (ToggleViewAction && !ToggleViewAction->toolTip().isEmpty())
+		{
+			TabWidget->setToolTip(ToggleViewAction->toolTip());
+		}
+#endif
+	}
+	return TabWidget;
+}
+
+
 //============================================================================
 CDockWidget::CDockWidget(const QString &title, QWidget *parent) :
 	QFrame(parent),
@@ -243,8 +331,12 @@ CDockWidget::CDockWidget(const QString &title, QWidget *parent) :
 	setLayout(d->Layout);
 	setWindowTitle(title);
 	setObjectName(title);
+	CDockStyle::applyTo(this);
 
-	d->TabWidget = componentsFactory()->createDockWidgetTab(this);
+	if (!CDockManager::testPerformanceFlag(CDockManager::LazyDockWidgetTabCreation))
+	{
+		d->tabWidget();
+	}
     d->ToggleViewAction = new QAction(title, this);
 	d->ToggleViewAction->setCheckable(true);
 	connect(d->ToggleViewAction, SIGNAL(triggered(bool)), this,
@@ -293,14 +385,31 @@ void CDockWidget::setWidget(QWidget* widget, eInsertMode InsertMode)
 			ScrollAreaWidget->viewport()->setProperty("dockWidgetContent", true);
 		}
 	}
+	else if (CDockManager::testPerformanceFlag(CDockManager::LazyDockWidgetConstruction)
+		&& !testAttribute(Qt::WA_WState_Polished))
+	{
+		// The scroll area is created when this dock widget is polished, that
+		// means before it is shown or before its size hint is required
+		widget->setParent(this);
+		d->ScrollAreaDeferred = true;
+	}
 	else
 	{
 		d->setupScrollArea();
 		d->ScrollArea->setWidget(widget);
 	}
 
+	if (!ScrollAreaWidget && ForceNoScrollArea != InsertMode)
+	{
+		widget->installEventFilter(this);
+	}
 	d->Widget = widget;
 	d->Widget->setProperty("dockWidgetContent", true);
+	d->updateMinimumSizeHint();
+	if (d->DockManager)
+	{
+		d->DockManager->notifyDockWidgetContentChanged();
+	}
 }
 
 
@@ -322,10 +431,17 @@ QWidget* CDockWidget::takeWidget()
         w = d->Widget;
 	}
     d->Widget = nullptr;
+    d->ScrollAreaDeferred = false;
+    d->updateMinimumSizeHint();
 
 	if (w)
 	{
+		w->removeEventFilter(this);
 		w->setParent(nullptr);
+		if (d->DockManager)
+		{
+			d->DockManager->notifyDockWidgetContentChanged();
+		}
 	}
     return w;
 }
@@ -341,6 +457,10 @@ QWidget* CDockWidget::widget() const
 void CDockWidget::setGroupName(const QString &group)
 {
     d->GroupName = group;
+    if (d->DockManager)
+    {
+        d->DockManager->onDockWidgetGroupChanged(this);
+    }
 }
 
 //============================================================================
@@ -353,7 +473,7 @@ QString CDockWidget::getGroupName() const
 //============================================================================
 CDockWidgetTab* CDockWidget::tabWidget() const
 {
-	return d->TabWidget;
+	return d->tabWidget();
 }
 
 
@@ -366,7 +486,10 @@ void CDockWidget::setFeatures(DockWidgetFeatures features)
 	}
 	d->Features = features;
 	emit featuresChanged(d->Features);
-	d->TabWidget->onDockWidgetFeaturesChanged();
+	if (d->TabWidget)
+	{
+		d->TabWidget->onDockWidgetFeaturesChanged();
+	}
 	if(CDockAreaWidget* DockArea = dockAreaWidget())
 		DockArea->onDockWidgetFeaturesChanged();
 }
@@ -478,7 +601,7 @@ void CDockWidget::setToggleViewActionMode(eToggleViewActionMode Mode)
 	else
 	{
 		d->ToggleViewAction->setCheckable(false);
-		d->ToggleViewAction->setIcon(d->TabWidget->icon());
+		d->ToggleViewAction->setIcon(icon());
 	}
 }
 
@@ -487,6 +610,7 @@ void CDockWidget::setToggleViewActionMode(eToggleViewActionMode Mode)
 void CDockWidget::setMinimumSizeHintMode(eMinimumSizeHintMode Mode)
 {
 	d->MinimumSizeHintMode = Mode;
+	d->updateMinimumSizeHint();
 }
 
 
@@ -606,6 +730,10 @@ bool CDockWidget::event(QEvent *e)
 {
 	switch (e->type())
 	{
+	case QEvent::Polish:
+		d->createDeferredScrollArea();
+		break;
+
 	case QEvent::Hide:
 		emit visibilityChanged(false);
 		break;
@@ -614,6 +742,16 @@ bool CDockWidget::event(QEvent *e)
 		emit visibilityChanged(geometry().right() >= 0 && geometry().bottom() >= 0);
         break;
 
+	// The minimum size hint of the content may have changed
+	case QEvent::LayoutRequest:
+	case QEvent::FontChange:
+	case QEvent::StyleChange:
+		if (d->MinimumSizeHintMode == CDockWidget::MinimumSizeHintFromContent)
+		{
+			d->updateMinimumSizeHint();
+		}
+		break;
+
 	case QEvent::WindowTitleChange :
 		{
 			const auto title = windowTitle();
@@ -641,6 +779,31 @@ bool CDockWidget::event(QEvent *e)
 }
 
 
+//============================================================================
+bool CDockWidget::eventFilter(QObject* watched, QEvent* event)
+{
+	if (watched != d->Widget
+	 || d->MinimumSizeHintMode != CDockWidget::MinimumSizeHintFromContent)
+	{
+		return Super::eventFilter(watched, event);
+	}
+
+	switch (event->type())
+	{
+	case QEvent::LayoutRequest:
+	case QEvent::FontChange:
+	case QEvent::StyleChange:
+		d->updateMinimumSizeHint();
+		break;
+
+	default:
+		break;
+	}
+
+	return Super::eventFilter(watched, event);
+}
+
+
 #ifndef QT_NO_TOOLTIP
 //============================================================================
 void CDockWidget::setTabToolTip(const QString &text)
@@ -664,7 +827,11 @@ void CDockWidget::setTabToolTip(const QString &text)
 //============================================================================
 void CDockWidget::setIcon(const QIcon& Icon)
 {
-	d->TabWidget->setIcon(Icon);
+	d->Icon = Icon;
+	if (d->TabWidget)
+	{
+		d->TabWidget->setIcon(Icon);
+	}
 	if (!d->ToggleViewAction->isCheckable())
 	{
 		d->ToggleViewAction->setIcon(Icon);
@@ -675,7 +842,7 @@ void CDockWidget::setIcon(const QIcon& Icon)
 //============================================================================
 QIcon CDockWidget::icon() const
 {
-	return d->TabWidget->icon();
+	return d->TabWidget ? d->TabWidget->icon() : d->Icon;
 }
 
 
@@ -824,6 +991,61 @@ void CDockWidget::setClosedState(bool Closed)
 }
 
 
+//============================================================================
+void CDockWidget::setRestoreDirty(bool Dirty)
+{
+	d->RestoreDirty = Dirty;
+}
+
+
+//============================================================================
+bool CDockWidget::isRestoreDirty() const
+{
+	return d->RestoreDirty;
+}
+
+
+//============================================================================
+void CDockWidget::setRestoreClosed(bool Closed)
+{
+	d->RestoreClosed = Closed;
+}
+
+
+//============================================================================
+bool CDockWidget::isRestoreClosed() const
+{
+	return d->RestoreClosed;
+}
+
+
+//============================================================================
+void CDockWidget::beginInteraction()
+{
+	if (d->InteractionDepth++ == 0)
+	{
+		emit interactionStarted();
+	}
+}
+
+
+//============================================================================
+void CDockWidget::endInteraction()
+{
+	if (d->InteractionDepth > 0 && --d->InteractionDepth == 0)
+	{
+		emit interactionFinished();
+	}
+}
+
+
+//============================================================================
+bool CDockWidget::isInteractionActive() const
+{
+	return d->InteractionDepth > 0;
+}
+
+
 //============================================================================
 QSize CDockWidget::minimumSizeHint() const
 {
@@ -831,10 +1053,12 @@ QSize CDockWidget::minimumSizeHint() const
 	{
 		return QSize(60, 40);
 	}
-	else
+
+	if (!d->MinimumSizeHint.isValid())
 	{
-		return d->Widget->minimumSizeHint();
+		d->MinimumSizeHint = d->Widget->minimumSizeHint();
 	}
+	return d->MinimumSizeHint;
 }
 
 
@@ -845,7 +1069,7 @@ void CDockWidget::setFloating()
 	{
 		return;
 	}
-	d->TabWidget->detachDockWidget();
+	d->tabWidget()->detachDockWidget();
 }
 
 
@@ -883,11 +1107,10 @@ bool CDockWidget::closeDockWidgetInternal(bool ForceClose)
 		// delete the floating widget
 		if (isFloating())
 		{
-			CFloatingDockContainer* FloatingWidget = internal::findParent<
-					CFloatingDockContainer*>(this);
+			CFloatingDockContainer* FloatingWidget = dockContainer()->floatingWidget();
 			if (FloatingWidget->dockWidgets().count() == 1)
 			{
-				FloatingWidget->deleteLater();
+				dockManager()->releaseFloatingWidget(FloatingWidget);
 			}
 			else
 			{
@@ -910,7 +1133,10 @@ void CDockWidget::renameDockWidget(const QString &name, const QString &objectNam
 {
     setWindowTitle(name);
     setObjectName(objectName);
-    d->TabWidget->setText(name);
+    if (d->TabWidget)
+    {
+        d->TabWidget->setText(name);
+    }
     d->ToggleViewAction->setText(name);
 }
 
@@ -130,6 +130,24 @@ protected:
      */
     void setClosedState(bool Closed);
 
+    /**
+     * Internal restore bookkeeping. A dock widget is dirty from the start of
+     * a state restore until the saved state assigns it to a dock area. The
+     * restore closed state is the closed state read from the saved state
+     */
+    void setRestoreDirty(bool Dirty);
+    bool isRestoreDirty() const;
+    void setRestoreClosed(bool Closed);
+    bool isRestoreClosed() const;
+
+    /**
+     * The dock manager calls these functions if an interactive operation
+     * that affects this dock widget starts or finishes. Interactions are
+     * reference counted
+     */
+    void beginInteraction();
+    void endInteraction();
+
     /**
      * Internal toggle view function that does not check if the widget
      * already is in the given state
@@ -147,6 +165,13 @@ protected:
      */
     void renameDockWidget(const QString &name, const QString &objectName);
 
+    /**
+     * Watches the content widget if it is inside the scroll area. Layout
+     * requests of the content then do not reach this dock widget, so the
+     * cached minimum size hint is invalidated here
+     */
+    virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
 public:
     using Super = QFrame;
 
@@ -356,6 +381,12 @@ public:
      */
     bool isClosed() const;
 
+    /**
+     * Returns true, if an interactive operation like a splitter drag or a
+     * floating widget resize that affects this dock widget is active.
+     */
+    bool isInteractionActive() const;
+
     /**
      * Returns a checkable action that can be used to show or close this dock widget.
      * The action's text is set to the dock widget's window title.
@@ -598,6 +629,20 @@ signals:
      * The features parameter gives the new value of the property.
      */
     void featuresChanged(ads::CDockWidget::DockWidgetFeatures features);
+
+    /**
+     * This signal is emitted if an interactive operation that affects this
+     * dock widget starts, like a splitter drag, a floating widget resize,
+     * an undock drag or a state restore. The content may switch to a cheap
+     * rendering mode until interactionFinished() is emitted
+     */
+    void interactionStarted();
+
+    /**
+     * This signal is emitted if the last interactive operation that
+     * affects this dock widget finished
+     */
+    void interactionFinished();
 }; // class DockWidget
 }
  // namespace ads
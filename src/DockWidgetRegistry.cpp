@@ -0,0 +1,288 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockWidgetRegistry.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CDockWidgetRegistry class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "DockWidgetRegistry.h"
+
+#include <QHash>
+#include <QStringList>
+
+#include "DockWidget.h"
+
+namespace ads
+{
+/**
+ * Index data of a registered dock widget
+ */
+struct RegistryEntry
+{
+	QString Name; ///< object name the dock widget is registered with
+	QString Group; ///< group name the dock widget is registered with
+	int Index = -1; ///< index in the DockWidgets vector
+	int GroupIndex = -1; ///< index in the vector of its group
+};
+
+
+/**
+ * Private data class of CDockWidgetRegistry class (pimpl)
+ */
+struct DockWidgetRegistryPrivate
+{
+	QVector<CDockWidget*> DockWidgets;
+	QHash<CDockWidget*, RegistryEntry> Entries;
+	QHash<QString, CDockWidget*> ByName;
+	QHash<QString, QVector<CDockWidget*>> ByGroup;
+
+	/**
+	 * Removes the element at the given index from the given vector by
+	 * moving the last element into its place. Returns the moved element or
+	 * a nullptr if no element has been moved.
+	 */
+	static CDockWidget* takeAt(QVector<CDockWidget*>& Vector, int Index)
+	{
+		CDockWidget* Moved = nullptr;
+		int Last = Vector.count() - 1;
+		if (Index != Last)
+		{
+			Moved = Vector[Last];
+			Vector[Index] = Moved;
+		}
+		Vector.removeLast();
+		return Moved;
+	}
+
+	/**
+	 * Appends the dock widget to its group
+	 */
+	void addToGroup(CDockWidget* DockWidget, RegistryEntry& Entry)
+	{
+		auto& Group = ByGroup[Entry.Group];
+		Entry.GroupIndex = Group.count();
+		Group.append(DockWidget);
+	}
+
+	/**
+	 * Removes the dock widget from its group
+	 */
+	void removeFromGroup(const RegistryEntry& Entry)
+	{
+		auto it = ByGroup.find(Entry.Group);
+		auto Moved = takeAt(it.value(), Entry.GroupIndex);
+		if (Moved)
+		{
+			Entries[Moved].GroupIndex = Entry.GroupIndex;
+		}
+		if (it.value().isEmpty())
+		{
+			ByGroup.erase(it);
+		}
+	}
+};
+// struct DockWidgetRegistryPrivate
+
+
+//============================================================================
+CDockWidgetRegistry::CDockWidgetRegistry() :
+	d(new DockWidgetRegistryPrivate())
+{
+
+}
+
+
+//============================================================================
+CDockWidgetRegistry::~CDockWidgetRegistry()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CDockWidgetRegistry::add(CDockWidget* DockWidget)
+{
+	if (contains(DockWidget))
+	{
+		updateName(DockWidget);
+		updateGroup(DockWidget);
+		return;
+	}
+
+	const auto Name = DockWidget->objectName();
+	auto Replaced = d->ByName.value(Name, nullptr);
+	if (Replaced)
+	{
+		remove(Replaced);
+	}
+
+	RegistryEntry Entry;
+	Entry.Name = Name;
+	Entry.Group = DockWidget->getGroupName();
+	Entry.Index = d->DockWidgets.count();
+	d->DockWidgets.append(DockWidget);
+	d->ByName.insert(Name, DockWidget);
+	d->addToGroup(DockWidget, Entry);
+	d->Entries.insert(DockWidget, Entry);
+}
+
+
+//============================================================================
+void CDockWidgetRegistry::remove(CDockWidget* DockWidget)
+{
+	auto it = d->Entries.find(DockWidget);
+	if (it == d->Entries.end())
+	{
+		return;
+	}
+
+	const RegistryEntry Entry = it.value();
+	d->Entries.erase(it);
+	auto Moved = DockWidgetRegistryPrivate::takeAt(d->DockWidgets, Entry.Index);
+	if (Moved)
+	{
+		d->Entries[Moved].Index = Entry.Index;
+	}
+	d->removeFromGroup(Entry);
+	d->ByName.remove(Entry.Name);
+}
+
+
+//============================================================================
+void CDockWidgetRegistry::updateName(CDockWidget* DockWidget)
+{
+	auto it = d->Entries.find(DockWidget);
+	if (it == d->Entries.end())
+	{
+		return;
+	}
+
+	const auto Name = DockWidget->objectName();
+	if (it->Name == Name)
+	{
+		return;
+	}
+
+	// Like an insertion into a map, the new name replaces a different dock
+	// widget that is registered with the same name
+	auto Replaced = d->ByName.value(Name, nullptr);
+	if (Replaced)
+	{
+		remove(Replaced);
+		it = d->Entries.find(DockWidget);
+	}
+
+	d->ByName.remove(it->Name);
+	it->Name = Name;
+	d->ByName.insert(Name, DockWidget);
+}
+
+
+//============================================================================
+void CDockWidgetRegistry::updateGroup(CDockWidget* DockWidget)
+{
+	auto it = d->Entries.find(DockWidget);
+	if (it == d->Entries.end())
+	{
+		return;
+	}
+
+	const auto Group = DockWidget->getGroupName();
+	if (it->Group == Group)
+	{
+		return;
+	}
+
+	d->removeFromGroup(it.value());
+	it->Group = Group;
+	d->addToGroup(DockWidget, it.value());
+}
+
+
+//============================================================================
+CDockWidget* CDockWidgetRegistry::find(const QString& ObjectName) const
+{
+	return d->ByName.value(ObjectName, nullptr);
+}
+
+
+//============================================================================
+bool CDockWidgetRegistry::contains(CDockWidget* DockWidget) const
+{
+	return d->Entries.contains(DockWidget);
+}
+
+
+//============================================================================
+int CDockWidgetRegistry::count() const
+{
+	return d->DockWidgets.count();
+}
+
+
+//============================================================================
+bool CDockWidgetRegistry::isEmpty() const
+{
+	return d->DockWidgets.isEmpty();
+}
+
+
+//============================================================================
+const QVector<CDockWidget*>& CDockWidgetRegistry::dockWidgets() const
+{
+	return d->DockWidgets;
+}
+
+
+//============================================================================
+const QVector<CDockWidget*>& CDockWidgetRegistry::group(const QString& GroupName) const
+{
+	static const QVector<CDockWidget*> EmptyGroup;
+	auto it = d->ByGroup.constFind(GroupName);
+	return (it != d->ByGroup.constEnd()) ? it.value() : EmptyGroup;
+}
+
+
+//============================================================================
+QStringList CDockWidgetRegistry::groupNames() const
+{
+	return d->ByGroup.keys();
+}
+
+
+//============================================================================
+QMap<QString, CDockWidget*> CDockWidgetRegistry::toMap() const
+{
+	QMap<QString, CDockWidget*> Map;
+	for (auto it = d->ByName.constBegin(); it != d->ByName.constEnd(); ++it)
+	{
+		Map.insert(it.key(), it.value());
+	}
+	return Map;
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF DockWidgetRegistry.cpp
@@ -0,0 +1,159 @@
+#ifndef DockWidgetRegistryH
+#define DockWidgetRegistryH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   DockWidgetRegistry.h
+/// \date   18.10.2026
+/// \brief  Declaration of CDockWidgetRegistry class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QMap>
+#include <QStringList>
+#include <QVector>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+class CDockWidget;
+struct DockWidgetRegistryPrivate;
+
+/**
+ * Registry of all dock widgets of a dock manager.
+ * The registry provides hashed lookup by object name, by dock widget pointer
+ * and by group name. The registered dock widgets are stored in flat vectors
+ * that can be iterated without any allocation via dockWidgets(), group() or
+ * forEach(). The iteration order is unspecified - it changes if a dock
+ * widget is removed.
+ */
+class ADS_EXPORT CDockWidgetRegistry
+{
+private:
+	DockWidgetRegistryPrivate* d; ///< private data (pimpl)
+	friend struct DockWidgetRegistryPrivate;
+
+public:
+	/**
+	 * Default Constructor
+	 */
+	CDockWidgetRegistry();
+
+	/**
+	 * Destructor
+	 */
+	~CDockWidgetRegistry();
+
+	CDockWidgetRegistry(const CDockWidgetRegistry&) = delete;
+	CDockWidgetRegistry& operator=(const CDockWidgetRegistry&) = delete;
+
+	/**
+	 * Registers the given dock widget with its current object name and
+	 * group name. If the dock widget is already registered, its name and
+	 * group are updated. A different dock widget that is registered with
+	 * the same object name is replaced.
+	 */
+	void add(CDockWidget* DockWidget);
+
+	/**
+	 * Removes the given dock widget from the registry
+	 */
+	void remove(CDockWidget* DockWidget);
+
+	/**
+	 * Updates the name index after the object name of the given dock widget
+	 * has been changed
+	 */
+	void updateName(CDockWidget* DockWidget);
+
+	/**
+	 * Updates the group index after the group name of the given dock widget
+	 * has been changed
+	 */
+	void updateGroup(CDockWidget* DockWidget);
+
+	/**
+	 * Returns the dock widget that is registered with the given object name
+	 * or a nullptr if no such dock widget exists
+	 */
+	CDockWidget* find(const QString& ObjectName) const;
+
+	/**
+	 * Returns true, if the given dock widget is registered
+	 */
+	bool contains(CDockWidget* DockWidget) const;
+
+	/**
+	 * Returns the number of registered dock widgets
+	 */
+	int count() const;
+
+	/**
+	 * Returns true, if no dock widget is registered
+	 */
+	bool isEmpty() const;
+
+	/**
+	 * Returns all registered dock widgets.
+	 * The returned reference is invalidated by the next change of the
+	 * registry.
+	 */
+	const QVector<CDockWidget*>& dockWidgets() const;
+
+	/**
+	 * Returns all registered dock widgets with the given group name.
+	 * The returned reference is invalidated by the next change of the
+	 * registry.
+	 */
+	const QVector<CDockWidget*>& group(const QString& GroupName) const;
+
+	/**
+	 * Returns the names of all groups that contain at least one dock widget
+	 */
+	QStringList groupNames() const;
+
+	/**
+	 * Calls the given visitor for each registered dock widget.
+	 * The visitor must not add or remove dock widgets.
+	 */
+	template <typename Visitor>
+	void forEach(Visitor&& Visit) const
+	{
+		for (auto DockWidget : dockWidgets())
+		{
+			Visit(DockWidget);
+		}
+	}
+
+	/**
+	 * Returns a map from object name to dock widget.
+	 * This function allocates a new map on each call and is provided for
+	 * CDockManager::dockWidgetsMap() compatibility.
+	 */
+	QMap<QString, CDockWidget*> toMap() const;
+}; // class CDockWidgetRegistry
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // DockWidgetRegistryH
@@ -50,6 +50,7 @@
 #include "DockOverlay.h"
 #include "DockManager.h"
 #include "IconProvider.h"
+#include "DockStyle.h"
 
 #include <iostream>
 
@@ -140,6 +141,22 @@ struct DockWidgetTabPrivate
 		}
 	}
 
+	/**
+	 * Creates the close button and adds it to the tab layout, if it does
+	 * not exist yet
+	 */
+	void ensureCloseButton();
+
+	/**
+	 * Returns true, if the close button needs to reserve its space in the
+	 * tab even if it is hidden
+	 */
+	bool closeButtonRetainsSize() const
+	{
+		return DockWidget->features().testFlag(CDockWidget::DockWidgetClosable)
+			&& testConfigFlag(CDockManager::RetainTabSizeWhenCloseButtonHidden);
+	}
+
 	/**
 	 * Update the close button visibility from current feature/config
 	 */
@@ -149,7 +166,15 @@ struct DockWidgetTabPrivate
 		bool ActiveTabHasCloseButton = testConfigFlag(CDockManager::ActiveTabHasCloseButton);
 		bool AllTabsHaveCloseButton = testConfigFlag(CDockManager::AllTabsHaveCloseButton);
 		bool TabHasCloseButton = (ActiveTabHasCloseButton && active) | AllTabsHaveCloseButton;
-		CloseButton->setVisible(DockWidgetClosable && TabHasCloseButton);
+		bool Visible = DockWidgetClosable && TabHasCloseButton;
+		// A close button that has not been created yet, does not need to be
+		// created for hiding it
+		if (!CloseButton && !Visible)
+		{
+			return;
+		}
+		ensureCloseButton();
+		CloseButton->setVisible(Visible);
 	}
 
 	/**
@@ -158,10 +183,13 @@ struct DockWidgetTabPrivate
 	 */
 	void updateCloseButtonSizePolicy()
 	{
-		auto Features = DockWidget->features();
+		if (!CloseButton && !closeButtonRetainsSize())
+		{
+			return;
+		}
+		ensureCloseButton();
 		auto SizePolicy = CloseButton->sizePolicy();
-		SizePolicy.setRetainSizeWhenHidden(Features.testFlag(CDockWidget::DockWidgetClosable)
-			&& testConfigFlag(CDockManager::RetainTabSizeWhenCloseButtonHidden));
+		SizePolicy.setRetainSizeWhenHidden(closeButtonRetainsSize());
 		CloseButton->setSizePolicy(SizePolicy);
 	}
 
@@ -170,7 +198,7 @@ struct DockWidgetTabPrivate
 	{
 		if (OpaqueUndocking)
 		{
-			return new CFloatingDockContainer(Widget);
+			return CFloatingDockContainer::createFloatingWidget(Widget);
 		}
 		else
 		{
@@ -214,15 +242,6 @@ void DockWidgetTabPrivate::createLayout()
 	TitleLabel->setAlignment(Qt::AlignCenter);
 	_this->connect(TitleLabel, SIGNAL(elidedChanged(bool)), SIGNAL(elidedChanged(bool)));
 
-
-	CloseButton = createCloseButton();
-	CloseButton->setObjectName("tabCloseButton");
-    CloseButton->setFixedSize(24, 24);
-    CloseButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
-    updateCloseButtonSizePolicy();
-	internal::setToolTip(CloseButton, QObject::tr("Close Tab"));
-	_this->connect(CloseButton, SIGNAL(clicked()), SIGNAL(closeRequested()));
-
 	QFontMetrics fm(TitleLabel->font());
     int Spacing = qRound(fm.height() / 2.0);
 
@@ -233,12 +252,37 @@ void DockWidgetTabPrivate::createLayout()
 	_this->setLayout(Layout);
 	Layout->addWidget(TitleLabel, 1);
     Layout->addSpacing(Spacing);
-	Layout->addWidget(CloseButton);
 	Layout->setAlignment(Qt::AlignCenter);
 
+	// In lazy construction mode, the close button is created when it
+	// becomes visible for the first time
+	if (!CDockManager::testPerformanceFlag(CDockManager::LazyDockWidgetConstruction))
+	{
+		ensureCloseButton();
+	}
+	updateCloseButtonSizePolicy();
+
 	TitleLabel->setVisible(true);
 }
 
+
+//============================================================================
+void DockWidgetTabPrivate::ensureCloseButton()
+{
+	if (CloseButton)
+	{
+		return;
+	}
+
+	CloseButton = createCloseButton();
+	CloseButton->setObjectName("tabCloseButton");
+    CloseButton->setFixedSize(24, 24);
+    CloseButton->setSizePolicy(QSizePolicy::Fixed, QSizePolicy::Fixed);
+	internal::setToolTip(CloseButton, QObject::tr("Close Tab"));
+	_this->connect(CloseButton, SIGNAL(clicked()), SIGNAL(closeRequested()));
+	_this->layout()->addWidget(CloseButton);
+}
+
 //============================================================================
 void DockWidgetTabPrivate::moveTab(QMouseEvent* ev)
 {
@@ -250,6 +294,7 @@ void DockWidgetTabPrivate::moveTab(QMouseEvent* ev)
     TargetPos.rx() = qMin(_this->parentWidget()->rect().right() - _this->width() + 1, TargetPos.rx());
     _this->move(TargetPos);
     _this->raise();
+    emit _this->moving(ev->globalPos());
 }
 
 
@@ -329,6 +374,7 @@ CDockWidgetTab::CDockWidgetTab(CDockWidget* DockWidget, QWidget *parent) :
 	{
 		setFocusPolicy(Qt::ClickFocus);
 	}
+	CDockStyle::applyTo(this, true);
 }
 
 //============================================================================
@@ -167,6 +167,7 @@ signals:
 	void clicked();
 	void closeRequested();
 	void closeOtherTabsRequested();
+	void moving(const QPoint& GlobalPos);
 	void moved(const QPoint& GlobalPos);
 	void elidedChanged(bool elided);
 }; // class DockWidgetTab
@@ -42,11 +42,23 @@ struct ElidingLabelPrivate
 	Qt::TextElideMode ElideMode = Qt::ElideNone;
 	QString Text;
 	bool IsElided = false;
+	mutable QSize SizeHint;
+	mutable QSize MinimumSizeHint;
 
 	ElidingLabelPrivate(CElidingLabel* _public) : _this(_public) {}
 
 	void elideText(int Width);
 
+	/**
+	 * Invalidates the cached size hints. The hints are recomputed on the
+	 * next query
+	 */
+	void invalidateSizeHints()
+	{
+		SizeHint = QSize();
+		MinimumSizeHint = QSize();
+	}
+
 	/**
 	 * Convenience function to check if the
 	 */
@@ -76,7 +88,12 @@ void ElidingLabelPrivate::elideText(int Width)
     {
         emit _this->elidedChanged(IsElided);
     }
-    _this->QLabel::setText(str);
+    // QLabel::setText() always triggers a geometry update - we skip it if
+    // the visible text does not change
+    if (str != _this->QLabel::text())
+    {
+    	_this->QLabel::setText(str);
+    }
 }
 
 
@@ -117,7 +134,9 @@ Qt::TextElideMode CElidingLabel::elideMode() const
 void CElidingLabel::setElideMode(Qt::TextElideMode mode)
 {
 	d->ElideMode = mode;
+	d->invalidateSizeHints();
 	d->elideText(size().width());
+	updateGeometry();
 }
 
 //============================================================================
@@ -160,6 +179,29 @@ void CElidingLabel::resizeEvent(QResizeEvent *event)
 }
 
 
+//============================================================================
+void CElidingLabel::changeEvent(QEvent* event)
+{
+	switch (event->type())
+	{
+	case QEvent::FontChange:
+	case QEvent::StyleChange:
+	case QEvent::ContentsRectChange:
+		d->invalidateSizeHints();
+		if (!d->isModeElideNone())
+		{
+			d->elideText(size().width());
+			updateGeometry();
+		}
+		break;
+
+	default:
+		break;
+	}
+	Super::changeEvent(event);
+}
+
+
 //============================================================================
 QSize CElidingLabel::minimumSizeHint() const
 {
@@ -167,12 +209,17 @@ QSize CElidingLabel::minimumSizeHint() const
     {
         return QLabel::minimumSizeHint();
     }
+    if (d->MinimumSizeHint.isValid())
+    {
+    	return d->MinimumSizeHint;
+    }
     const QFontMetrics  &fm = fontMetrics();
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
         QSize size(fm.horizontalAdvance(d->Text.left(2) + "…"), fm.height());
     #else
         QSize size(fm.width(d->Text.left(2) + "…"), fm.height());
     #endif
+    d->MinimumSizeHint = size;
     return size;
 }
 
@@ -184,12 +231,17 @@ QSize CElidingLabel::sizeHint() const
     {
         return QLabel::sizeHint();
     }
+    if (d->SizeHint.isValid())
+    {
+    	return d->SizeHint;
+    }
     const QFontMetrics& fm = fontMetrics();
     #if (QT_VERSION >= QT_VERSION_CHECK(5, 11, 0))
         QSize size(fm.horizontalAdvance(d->Text), QLabel::sizeHint().height());
     #else
         QSize size(fm.width(d->Text), QLabel::sizeHint().height());
     #endif
+    d->SizeHint = size;
 	return size;
 }
 
@@ -197,7 +249,13 @@ QSize CElidingLabel::sizeHint() const
 //============================================================================
 void CElidingLabel::setText(const QString &text)
 {
+	if (text == d->Text)
+	{
+		return;
+	}
+
 	d->Text = text;
+	d->invalidateSizeHints();
 	if (d->isModeElideNone())
 	{
 		Super::setText(text);
@@ -206,6 +264,7 @@ void CElidingLabel::setText(const QString &text)
 	{
 		internal::setToolTip(this, text);
 		d->elideText(this->size().width());
+		updateGeometry();
 	}
 }
 
@@ -54,6 +54,7 @@ protected:
 	virtual void mouseReleaseEvent(QMouseEvent* event) override;
     virtual void resizeEvent( QResizeEvent *event ) override;
     virtual void mouseDoubleClickEvent( QMouseEvent *ev ) override;
+    virtual void changeEvent(QEvent* event) override;
 
 public:
     using Super = QLabel;
@@ -0,0 +1,236 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   FilterPopup.cpp
+/// \date   19.10.2026
+/// \brief  Implementation of CFilterPopup class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "FilterPopup.h"
+
+#include <QApplication>
+#include <QBoxLayout>
+#include <QKeyEvent>
+#include <QLineEdit>
+#include <QListView>
+#include <QSortFilterProxyModel>
+
+namespace ads
+{
+/**
+ * Private data class of CFilterPopup class (pimpl)
+ */
+struct FilterPopupPrivate
+{
+	CFilterPopup* _this;
+	QSortFilterProxyModel* ProxyModel;
+	QLineEdit* FilterEdit;
+	QListView* ListView;
+
+	/**
+	 * Private data constructor
+	 */
+	FilterPopupPrivate(CFilterPopup* _public) : _this(_public) {}
+
+	/**
+	 * Creates the filter line edit and the list view
+	 */
+	void createLayout();
+
+	/**
+	 * Selects the first row of the filtered list if no row is selected
+	 */
+	void ensureCurrentRow();
+};
+// struct FilterPopupPrivate
+
+
+//============================================================================
+void FilterPopupPrivate::createLayout()
+{
+	FilterEdit = new QLineEdit(_this);
+	FilterEdit->setClearButtonEnabled(true);
+	FilterEdit->installEventFilter(_this);
+
+	ListView = new QListView(_this);
+	// All rows have the same height, so the view does not need to query the
+	// size of all items and only lays out and paints the visible rows
+	ListView->setUniformItemSizes(true);
+	ListView->setEditTriggers(QAbstractItemView::NoEditTriggers);
+	ListView->setSelectionMode(QAbstractItemView::SingleSelection);
+	ListView->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+	ListView->setTextElideMode(Qt::ElideRight);
+	ListView->setFocusPolicy(Qt::NoFocus);
+	ListView->setModel(ProxyModel);
+
+	auto Layout = new QBoxLayout(QBoxLayout::TopToBottom);
+	Layout->setContentsMargins(2, 2, 2, 2);
+	Layout->setSpacing(2);
+	Layout->addWidget(FilterEdit);
+	Layout->addWidget(ListView, 1);
+	_this->setLayout(Layout);
+
+	_this->connect(FilterEdit, SIGNAL(textChanged(const QString&)),
+		SLOT(onFilterTextChanged(const QString&)));
+	_this->connect(ListView, SIGNAL(clicked(const QModelIndex&)),
+		SLOT(onItemActivated(const QModelIndex&)));
+}
+
+
+//============================================================================
+void FilterPopupPrivate::ensureCurrentRow()
+{
+	if (ListView->currentIndex().isValid() || !ProxyModel->rowCount())
+	{
+		return;
+	}
+
+	ListView->setCurrentIndex(ProxyModel->index(0, 0));
+}
+
+
+//============================================================================
+CFilterPopup::CFilterPopup(QSortFilterProxyModel* ProxyModel, QWidget* Parent) :
+	Super(Parent, Qt::Popup),
+	d(new FilterPopupPrivate(this))
+{
+	setFrameStyle(QFrame::StyledPanel | QFrame::Plain);
+	d->ProxyModel = ProxyModel;
+	d->ProxyModel->setParent(this);
+	d->ProxyModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
+	d->ProxyModel->setDynamicSortFilter(true);
+	d->createLayout();
+}
+
+
+//============================================================================
+CFilterPopup::~CFilterPopup()
+{
+	delete d;
+}
+
+
+//============================================================================
+QSortFilterProxyModel* CFilterPopup::proxyModel() const
+{
+	return d->ProxyModel;
+}
+
+
+//============================================================================
+QLineEdit* CFilterPopup::filterEdit() const
+{
+	return d->FilterEdit;
+}
+
+
+//============================================================================
+QListView* CFilterPopup::listView() const
+{
+	return d->ListView;
+}
+
+
+//============================================================================
+void CFilterPopup::showPopup(const QPoint& GlobalPos, int Width, int MaxRows,
+	const QModelIndex& CurrentIndex)
+{
+	d->FilterEdit->clear();
+	d->ListView->setCurrentIndex(d->ProxyModel->mapFromSource(CurrentIndex));
+	d->ensureCurrentRow();
+
+	// Only the height of a single row is required because all items have
+	// a uniform size
+	int RowCount = qMin(d->ProxyModel->rowCount(), MaxRows);
+	int RowHeight = d->ProxyModel->rowCount() ? d->ListView->sizeHintForRow(0) : 0;
+	int Height = d->FilterEdit->sizeHint().height() + qMax(RowCount, 1) * RowHeight
+		+ 2 * d->ListView->frameWidth() + 8;
+	resize(Width, Height);
+
+	move(GlobalPos);
+	show();
+	d->ListView->scrollTo(d->ListView->currentIndex());
+	d->FilterEdit->setFocus(Qt::PopupFocusReason);
+}
+
+
+//============================================================================
+void CFilterPopup::onFilterTextChanged(const QString& Text)
+{
+	d->ProxyModel->setFilterFixedString(Text);
+	d->ensureCurrentRow();
+}
+
+
+//============================================================================
+void CFilterPopup::onItemActivated(const QModelIndex& Index)
+{
+	if (!Index.isValid())
+	{
+		return;
+	}
+
+	int SourceRow = d->ProxyModel->mapToSource(Index).row();
+	hide();
+	activateRow(SourceRow);
+}
+
+
+//============================================================================
+bool CFilterPopup::eventFilter(QObject* watched, QEvent* event)
+{
+	if (watched != d->FilterEdit || event->type() != QEvent::KeyPress)
+	{
+		return Super::eventFilter(watched, event);
+	}
+
+	auto KeyEvent = static_cast<QKeyEvent*>(event);
+	switch (KeyEvent->key())
+	{
+	case Qt::Key_Up:
+	case Qt::Key_Down:
+	case Qt::Key_PageUp:
+	case Qt::Key_PageDown:
+		 QApplication::sendEvent(d->ListView, event);
+		 return true;
+
+	case Qt::Key_Return:
+	case Qt::Key_Enter:
+		 onItemActivated(d->ListView->currentIndex());
+		 return true;
+
+	case Qt::Key_Escape:
+		 hide();
+		 return true;
+
+	default:
+		break;
+	}
+
+	return Super::eventFilter(watched, event);
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF FilterPopup.cpp
@@ -0,0 +1,117 @@
+#ifndef FilterPopupH
+#define FilterPopupH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   FilterPopup.h
+/// \date   19.10.2026
+/// \brief  Declaration of CFilterPopup class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QFrame>
+#include <QModelIndex>
+
+#include "ads_globals.h"
+
+class QLineEdit;
+class QListView;
+class QSortFilterProxyModel;
+
+namespace ads
+{
+struct FilterPopupPrivate;
+
+/**
+ * Base class of popups that show a filter line edit on top of a list view.
+ * The list view has uniform item sizes, so only the visible rows are laid
+ * out and painted. Navigation keys typed into the filter line edit are
+ * forwarded to the list view. Subclasses provide the source model of the
+ * filter proxy model and implement activateRow().
+ */
+class ADS_EXPORT CFilterPopup : public QFrame
+{
+	Q_OBJECT
+private:
+	FilterPopupPrivate* d; ///< private data (pimpl)
+	friend struct FilterPopupPrivate;
+
+private slots:
+	void onFilterTextChanged(const QString& Text);
+	void onItemActivated(const QModelIndex& Index);
+
+protected:
+	/**
+	 * Forwards navigation keys from the filter line edit to the list view
+	 */
+	virtual bool eventFilter(QObject* watched, QEvent* event) override;
+
+	/**
+	 * This function is called if the user activates the given row of the
+	 * source model. The popup is already hidden at this point
+	 */
+	virtual void activateRow(int SourceRow) = 0;
+
+	/**
+	 * Clears the filter, makes the given source index the current row and
+	 * shows the popup with the given width and a height for at most MaxRows
+	 * rows. If CurrentIndex is invalid or filtered out, the first row
+	 * becomes the current row.
+	 */
+	void showPopup(const QPoint& GlobalPos, int Width, int MaxRows,
+		const QModelIndex& CurrentIndex = QModelIndex());
+
+public:
+	using Super = QFrame;
+
+	/**
+	 * Creates the popup for the given filter proxy model.
+	 * The popup takes ownership of the proxy model.
+	 */
+	CFilterPopup(QSortFilterProxyModel* ProxyModel, QWidget* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CFilterPopup();
+
+	/**
+	 * Returns the filter proxy model between the source model and the list
+	 * view
+	 */
+	QSortFilterProxyModel* proxyModel() const;
+
+	/**
+	 * Returns the filter line edit
+	 */
+	QLineEdit* filterEdit() const;
+
+	/**
+	 * Returns the list view
+	 */
+	QListView* listView() const;
+}; // class CFilterPopup
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // FilterPopupH
@@ -38,6 +38,7 @@
 #include <QDebug>
 #include <QAbstractButton>
 #include <QElapsedTimer>
+#include <QTimer>
 #include <QTime>
 
 #include "DockContainerWidget.h"
@@ -55,6 +56,9 @@
 #ifdef Q_OS_LINUX
 #include "linux/FloatingWidgetTitleBar.h"
 #include <xcb/xcb.h>
+#include <QX11Info>
+#include <QWindow>
+#include <QScreen>
 #endif
 
 namespace ads
@@ -371,12 +375,19 @@ struct FloatingDockContainerPrivate
 	QPoint DragStartMousePosition;
 	CDockContainerWidget *DropContainer = nullptr;
 	CDockAreaWidget *SingleDockArea = nullptr;
+	QPointer<CDockWidget> FocusedDockWidget;
+	QRect InitialGeometry;
 	QPoint DragStartPos;
 	bool Hiding = false;
+	int DragInteractionId = 0;
+	int ResizeInteractionId = 0;
+	QTimer* ResizeInteractionTimer = nullptr;
 #ifdef Q_OS_LINUX
     QWidget* MouseEventHandler = nullptr;
     CFloatingWidgetTitleBar* TitleBar = nullptr;
 	bool IsResizing = false;
+	QTimer* SystemMoveTimer = nullptr; ///< polls the cursor during a system move
+	QPoint SystemMoveCursorPos;
 #endif
 
 	/**
@@ -405,9 +416,40 @@ struct FloatingDockContainerPrivate
 
 	void setState(eDragState StateId)
 	{
+		if (StateId == DraggingState)
+		{
+			return;
+		}
+
 		DraggingState = StateId;
+		if (DraggingFloatingWidget == StateId)
+		{
+			beginInteraction(DragInteractionId);
+		}
+		else
+		{
+			endInteraction(DragInteractionId);
+		}
 	}
 
+	/**
+	 * Starts an interaction for the visible dock widgets of this floating
+	 * widget and stores its id in InteractionId
+	 */
+	void beginInteraction(int& InteractionId);
+
+	/**
+	 * Finishes the interaction with the given id and resets the id
+	 */
+	void endInteraction(int& InteractionId);
+
+	/**
+	 * Starts a resize interaction or extends the active one. Window systems
+	 * do not report the end of a resize, so the interaction finishes if
+	 * there was no resize for a short time
+	 */
+	void notifyResize();
+
 	void setWindowTitle(const QString &Text)
 	{
 #ifdef Q_OS_LINUX
@@ -452,6 +494,35 @@ struct FloatingDockContainerPrivate
 	 * Handles escape key press when dragging around the floating widget
 	 */
 	void handleEscapeKey();
+
+	/**
+	 * Moves the given dock area into the empty dock container
+	 */
+	void initDockArea(CDockAreaWidget* DockArea);
+
+	/**
+	 * Moves the given dock widget into the empty dock container
+	 */
+	void initDockWidget(CDockWidget* DockWidget);
+
+#ifdef Q_OS_LINUX
+	/**
+	 * Returns true, if the window manager currently moves this floating
+	 * widget
+	 */
+	bool isSystemMoveActive() const
+	{
+		return SystemMoveTimer && SystemMoveTimer->isActive();
+	}
+
+	/**
+	 * Called at frame rate during a system move. The window manager holds
+	 * the pointer grab, so the application receives no mouse events. This
+	 * function queries the pointer, updates the drop overlays if the cursor
+	 * has moved and finishes the drag if the left button has been released
+	 */
+	void pollSystemMove();
+#endif
 };
 // struct FloatingDockContainerPrivate
 
@@ -584,6 +655,66 @@ void FloatingDockContainerPrivate::updateDropOverlays(const QPoint &GlobalPos)
 }
 
 
+#ifdef Q_OS_LINUX
+/**
+ * Maps a position in native X11 root window coordinates to logical
+ * coordinates. Like QHighDpi::fromNativePixels() in Qt5, the position is
+ * mapped through the screen it is on, because each screen has its own
+ * scale factor. Qt5 keeps the origin of a screen unscaled, so the native
+ * origin is the top left corner of the logical screen geometry
+ */
+static QPoint nativeToLogicalPos(const QPoint& NativePos)
+{
+	for (auto Screen : QGuiApplication::screens())
+	{
+		const QRect Geometry = Screen->geometry();
+		const qreal Factor = Screen->devicePixelRatio();
+		const QRect NativeGeometry(Geometry.topLeft(), Geometry.size() * Factor);
+		if (NativeGeometry.contains(NativePos))
+		{
+			const QPointF Offset = QPointF(NativePos - Geometry.topLeft()) / Factor;
+			return Geometry.topLeft() + Offset.toPoint();
+		}
+	}
+
+	return NativePos;
+}
+
+
+//============================================================================
+void FloatingDockContainerPrivate::pollSystemMove()
+{
+	if (!isState(DraggingFloatingWidget) || !_this->isVisible())
+	{
+		SystemMoveTimer->stop();
+		return;
+	}
+
+	// One round trip to the X server delivers the button state and the
+	// pointer position in native root window coordinates
+	xcb_connection_t* Connection = QX11Info::connection();
+	auto Reply = xcb_query_pointer_reply(Connection,
+		xcb_query_pointer(Connection, QX11Info::appRootWindow()), nullptr);
+	if (!Reply || !(Reply->mask & XCB_BUTTON_MASK_1))
+	{
+		free(Reply);
+		SystemMoveTimer->stop();
+		_this->finishDragging();
+		return;
+	}
+
+	auto CursorPos = nativeToLogicalPos(QPoint(Reply->root_x, Reply->root_y));
+	free(Reply);
+	if (CursorPos == SystemMoveCursorPos)
+	{
+		return;
+	}
+	SystemMoveCursorPos = CursorPos;
+	updateDropOverlays(CursorPos);
+}
+#endif
+
+
 //============================================================================
 void FloatingDockContainerPrivate::handleEscapeKey()
 {
@@ -663,42 +794,173 @@ CFloatingDockContainer::CFloatingDockContainer(CDockManager *DockManager) :
 	l->addWidget(d->DockContainer);
 #endif
 
+	d->InitialGeometry = geometry();
 	DockManager->registerFloatingWidget(this);
 }
 
 //============================================================================
-CFloatingDockContainer::CFloatingDockContainer(CDockAreaWidget *DockArea) :
-	CFloatingDockContainer(DockArea->dockManager())
+void FloatingDockContainerPrivate::beginInteraction(int& InteractionId)
 {
-	d->DockContainer->addDockArea(DockArea);
+	if (InteractionId || !DockManager)
+	{
+		return;
+	}
+
+	QList<CDockWidget*> DockWidgets;
+	for (auto DockArea : DockContainer->openedDockAreas())
+	{
+		if (DockArea->currentDockWidget())
+		{
+			DockWidgets.append(DockArea->currentDockWidget());
+		}
+	}
+	InteractionId = DockManager->beginInteraction(DockWidgets);
+}
+
 
-    auto TopLevelDockWidget = topLevelDockWidget();
+//============================================================================
+void FloatingDockContainerPrivate::endInteraction(int& InteractionId)
+{
+	if (InteractionId && DockManager)
+	{
+		DockManager->endInteraction(InteractionId);
+	}
+	InteractionId = 0;
+}
+
+
+//============================================================================
+void FloatingDockContainerPrivate::notifyResize()
+{
+	if (!ResizeInteractionTimer)
+	{
+		ResizeInteractionTimer = new QTimer(_this);
+		ResizeInteractionTimer->setSingleShot(true);
+		ResizeInteractionTimer->setInterval(200);
+		QObject::connect(ResizeInteractionTimer, &QTimer::timeout, _this,
+			[this]() { endInteraction(ResizeInteractionId); });
+	}
+
+	beginInteraction(ResizeInteractionId);
+	ResizeInteractionTimer->start();
+}
+
+
+//============================================================================
+void FloatingDockContainerPrivate::initDockArea(CDockAreaWidget* DockArea)
+{
+	DockContainer->addDockArea(DockArea);
+
+    auto TopLevelDockWidget = _this->topLevelDockWidget();
     if (TopLevelDockWidget)
     {
     	TopLevelDockWidget->emitTopLevelChanged(true);
     }
 
-    d->DockManager->notifyWidgetOrAreaRelocation(DockArea);
+    DockManager->notifyWidgetOrAreaRelocation(DockArea);
 }
 
+
 //============================================================================
-CFloatingDockContainer::CFloatingDockContainer(CDockWidget *DockWidget) :
-	CFloatingDockContainer(DockWidget->dockManager())
+void FloatingDockContainerPrivate::initDockWidget(CDockWidget* DockWidget)
 {
-	d->DockContainer->addDockWidget(CenterDockWidgetArea, DockWidget);
-    auto TopLevelDockWidget = topLevelDockWidget();
+	DockContainer->addDockWidget(CenterDockWidgetArea, DockWidget);
+    auto TopLevelDockWidget = _this->topLevelDockWidget();
     if (TopLevelDockWidget)
     {
     	TopLevelDockWidget->emitTopLevelChanged(true);
     }
 
-    d->DockManager->notifyWidgetOrAreaRelocation(DockWidget);
+    DockManager->notifyWidgetOrAreaRelocation(DockWidget);
+}
+
+
+//============================================================================
+CFloatingDockContainer::CFloatingDockContainer(CDockAreaWidget *DockArea) :
+	CFloatingDockContainer(DockArea->dockManager())
+{
+	d->initDockArea(DockArea);
+}
+
+//============================================================================
+CFloatingDockContainer::CFloatingDockContainer(CDockWidget *DockWidget) :
+	CFloatingDockContainer(DockWidget->dockManager())
+{
+	d->initDockWidget(DockWidget);
+}
+
+
+//============================================================================
+CFloatingDockContainer* CFloatingDockContainer::createFloatingWidget(CDockAreaWidget* DockArea)
+{
+	auto FloatingWidget = DockArea->dockManager()->takePooledFloatingWidget();
+	if (!FloatingWidget)
+	{
+		return new CFloatingDockContainer(DockArea);
+	}
+
+	FloatingWidget->d->initDockArea(DockArea);
+	return FloatingWidget;
+}
+
+
+//============================================================================
+CFloatingDockContainer* CFloatingDockContainer::createFloatingWidget(CDockWidget* DockWidget)
+{
+	auto FloatingWidget = DockWidget->dockManager()
+		? DockWidget->dockManager()->takePooledFloatingWidget() : nullptr;
+	if (!FloatingWidget)
+	{
+		return new CFloatingDockContainer(DockWidget);
+	}
+
+	FloatingWidget->d->initDockWidget(DockWidget);
+	return FloatingWidget;
+}
+
+
+//============================================================================
+void CFloatingDockContainer::resetForReuse()
+{
+	// The dock areas have been moved into another container, so the
+	// container is cleared before the hide event can toggle their views
+	d->DockContainer->resetForReuse();
+	if (d->SingleDockArea)
+	{
+		disconnect(d->SingleDockArea, SIGNAL(currentChanged(int)), this,
+		    SLOT(onDockAreaCurrentChanged(int)));
+		d->SingleDockArea = nullptr;
+	}
+	hide();
+
+	d->setState(DraggingInactive);
+	d->endInteraction(d->ResizeInteractionId);
+	d->DropContainer = nullptr;
+	d->FocusedDockWidget = nullptr;
+	d->Hiding = false;
+	d->setWindowTitle(qApp->applicationDisplayName());
+	setWindowIcon(QApplication::windowIcon());
+	setWindowState(Qt::WindowNoState);
+#ifdef Q_OS_LINUX
+	d->MouseEventHandler = nullptr;
+	d->IsResizing = false;
+	if (d->TitleBar)
+	{
+		d->TitleBar->setMaximizedIcon(false);
+	}
+#endif
+	// Let the window manager place the window like a new window
+	setGeometry(d->InitialGeometry);
+	setAttribute(Qt::WA_Moved, false);
+	setAttribute(Qt::WA_Resized, false);
 }
 
 //============================================================================
 CFloatingDockContainer::~CFloatingDockContainer()
 {
 	ADS_PRINT("~CFloatingDockContainer");
+	d->endInteraction(d->DragInteractionId);
+	d->endInteraction(d->ResizeInteractionId);
 	if (d->DockManager)
 	{
 		d->DockManager->removeFloatingWidget(this);
@@ -712,6 +974,20 @@ CDockContainerWidget* CFloatingDockContainer::dockContainer() const
 	return d->DockContainer;
 }
 
+
+//============================================================================
+void CFloatingDockContainer::setFocusedDockWidget(CDockWidget* DockWidget)
+{
+	d->FocusedDockWidget = DockWidget;
+}
+
+
+//============================================================================
+CDockWidget* CFloatingDockContainer::focusedDockWidget() const
+{
+	return d->FocusedDockWidget.data();
+}
+
 //============================================================================
 void CFloatingDockContainer::changeEvent(QEvent *event)
 {
@@ -725,7 +1001,7 @@ void CFloatingDockContainer::changeEvent(QEvent *event)
 		if (d->DraggingState == DraggingFloatingWidget)
 		{
 			d->titleMouseReleaseEvent();
-			d->DraggingState = DraggingInactive;
+			d->setState(DraggingInactive);
 		}
 #endif
 	}
@@ -822,6 +1098,21 @@ void CFloatingDockContainer::closeEvent(QCloseEvent *event)
 	}
 }
 
+//============================================================================
+void CFloatingDockContainer::resizeEvent(QResizeEvent *event)
+{
+#ifdef Q_OS_LINUX
+	d->IsResizing = true;
+#endif
+	Super::resizeEvent(event);
+	// Only resizes by the user are reported as interactions
+	if (event->spontaneous() && isVisible() && !d->isState(DraggingFloatingWidget))
+	{
+		d->notifyResize();
+	}
+}
+
+
 //============================================================================
 void CFloatingDockContainer::hideEvent(QHideEvent *event)
 {
@@ -937,6 +1228,11 @@ bool CFloatingDockContainer::isClosable() const
 void CFloatingDockContainer::onDockAreasAddedOrRemoved()
 {
 	ADS_PRINT("CFloatingDockContainer::onDockAreasAddedOrRemoved()");
+	if (d->DockManager->deferTopLevelUpdate(d->DockContainer))
+	{
+		return;
+	}
+
 	auto TopLevelDockArea = d->DockContainer->topLevelDockArea();
 	if (TopLevelDockArea)
 	{
@@ -1212,11 +1508,46 @@ void CFloatingDockContainer::show()
 }
 
 
+
+
 //============================================================================
-void CFloatingDockContainer::resizeEvent(QResizeEvent *event)
+bool CFloatingDockContainer::startSystemMove()
 {
-	d->IsResizing = true;
-	Super::resizeEvent(event);
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 15, 0))
+	if (!CDockManager::testPerformanceFlag(CDockManager::SystemMoveFloatingWidgets)
+	 || !QX11Info::isPlatformX11() || isMaximized() || d->isSystemMoveActive())
+	{
+		return false;
+	}
+
+	auto Window = windowHandle();
+	if (!Window || !Window->startSystemMove())
+	{
+		return false;
+	}
+
+	// The window manager grabs the pointer now
+	if (d->MouseEventHandler)
+	{
+		d->MouseEventHandler->releaseMouse();
+		d->MouseEventHandler = nullptr;
+	}
+
+	if (!d->SystemMoveTimer)
+	{
+		d->SystemMoveTimer = new QTimer(this);
+		connect(d->SystemMoveTimer, &QTimer::timeout, this,
+			[this]() { d->pollSystemMove(); });
+	}
+	qreal RefreshRate = Window->screen() ? Window->screen()->refreshRate() : 60;
+	d->SystemMoveTimer->setInterval(qMax(1, qRound(1000 / qMax(RefreshRate, qreal(1)))));
+	d->SystemMoveCursorPos = QPoint();
+	d->setState(DraggingFloatingWidget);
+	d->SystemMoveTimer->start();
+	return true;
+#else
+	return false;
+#endif
 }
 
 
@@ -1224,9 +1555,16 @@ void CFloatingDockContainer::resizeEvent(QResizeEvent *event)
 void CFloatingDockContainer::moveEvent(QMoveEvent *event)
 {
 	Super::moveEvent(event);
+	// During a system move the drop overlays are updated by the cursor poll
+	if (d->isSystemMoveActive())
+	{
+		d->IsResizing = false;
+		return;
+	}
+
 	if (!d->IsResizing && event->spontaneous())
 	{
-		d->DraggingState = DraggingFloatingWidget;
+		d->setState(DraggingFloatingWidget);
 		d->updateDropOverlays(QCursor::pos());
 	}
 	d->IsResizing = false;
@@ -117,12 +117,21 @@ private:
 	friend class CDockWidget;
 	friend class CDockAreaWidget;
     friend class CFloatingWidgetTitleBar;
+	friend class CDockFocusController;
+	friend struct DockFocusControllerPrivate;
 
 private slots:
 	void onDockAreasAddedOrRemoved();
 	void onDockAreaCurrentChanged(int Index);
 
 protected:
+	/**
+	 * The focus controller stores the last focused dock widget of this
+	 * floating widget to restore the focus if the floating widget is dropped
+	 */
+	void setFocusedDockWidget(CDockWidget* DockWidget);
+	CDockWidget* focusedDockWidget() const;
+
 	/**
 	 * Starts floating at the given global position.
 	 * Use moveToGlobalPos() to move the widget to a new position
@@ -131,6 +140,13 @@ protected:
 	virtual void startFloating(const QPoint& DragStartMousePos, const QSize& Size,
         eDragState DragState, QWidget* MouseEventHandler) override;
 
+	/**
+	 * Clears this floating widget after its content has been dropped into
+	 * another container, so that the dock manager can put it into its
+	 * floating widget pool. Title, icon, geometry and focus state are reset
+	 */
+	void resetForReuse();
+
 	/**
 	 * Call this function to start dragging the floating widget
 	 */
@@ -161,6 +177,18 @@ protected:
 	 */
 	void moveFloating() override;
 
+#ifdef Q_OS_LINUX
+	/**
+	 * Hands the current drag of this floating widget over to the window
+	 * manager via QWindow::startSystemMove(). The window manager moves the
+	 * window without a configure request per mouse move and the drop
+	 * overlays are updated by polling the cursor at frame rate.
+	 * Returns false, if the SystemMoveFloatingWidgets performance flag is
+	 * not set or if the window manager does not support system moves.
+	 */
+	bool startSystemMove();
+#endif
+
 	/**
 	 * Restores the state from given stream.
 	 * If Testing is true, the function only parses the data from the given
@@ -179,6 +207,7 @@ protected: // reimplements QWidget
 	virtual void closeEvent(QCloseEvent *event) override;
 	virtual void hideEvent(QHideEvent *event) override;
 	virtual void showEvent(QShowEvent *event) override;
+	virtual void resizeEvent(QResizeEvent *event) override;
 
 #ifdef Q_OS_MACOS
 	virtual bool event(QEvent *e) override;
@@ -187,7 +216,6 @@ protected: // reimplements QWidget
 
 #ifdef Q_OS_LINUX
 	virtual void moveEvent(QMoveEvent *event) override;
-	virtual void resizeEvent(QResizeEvent *event) override;
 #endif
 
 #ifdef Q_OS_WIN
@@ -221,6 +249,21 @@ public:
 	 */
 	virtual ~CFloatingDockContainer();
 
+	/**
+	 * Returns a floating widget with the given dock area.
+	 * The floating widget is taken from the floating widget pool of the
+	 * dock manager if the pool is enabled and not empty.
+	 * See CDockManager::setFloatingWidgetPoolSize()
+	 */
+	static CFloatingDockContainer* createFloatingWidget(CDockAreaWidget* DockArea);
+
+	/**
+	 * Returns a floating widget with the given dock widget.
+	 * The floating widget is taken from the floating widget pool of the
+	 * dock manager if the pool is enabled and not empty
+	 */
+	static CFloatingDockContainer* createFloatingWidget(CDockWidget* DockWidget);
+
 	/**
 	 * Access function for the internal dock container
 	 */
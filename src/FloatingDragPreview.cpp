@@ -40,6 +40,7 @@ struct FloatingDragPreviewPrivate
 	bool Hidden = false;
 	QPixmap ContentPreviewPixmap;
 	bool Canceled = false;
+	int InteractionId = 0;
 
 
 	/**
@@ -192,11 +193,11 @@ void FloatingDragPreviewPrivate::createFloatingWidget()
 
 	if (DockWidget && DockWidget->features().testFlag(CDockWidget::DockWidgetFloatable))
 	{
-		FloatingWidget = new CFloatingDockContainer(DockWidget);
+		FloatingWidget = CFloatingDockContainer::createFloatingWidget(DockWidget);
 	}
 	else if (DockArea && DockArea->features().testFlag(CDockWidget::DockWidgetFloatable))
 	{
-		FloatingWidget = new CFloatingDockContainer(DockArea);
+		FloatingWidget = CFloatingDockContainer::createFloatingWidget(DockArea);
 	}
 
 	if (FloatingWidget)
@@ -286,6 +287,10 @@ CFloatingDragPreview::CFloatingDragPreview(CDockAreaWidget* Content)
 //============================================================================
 CFloatingDragPreview::~CFloatingDragPreview()
 {
+	if (d->InteractionId && d->DockManager)
+	{
+		d->DockManager->endInteraction(d->InteractionId);
+	}
 	delete d;
 }
 
@@ -307,6 +312,18 @@ void CFloatingDragPreview::startFloating(const QPoint &DragStartMousePos,
 {
 	Q_UNUSED(MouseEventHandler)
 	Q_UNUSED(DragState)
+	if (!d->InteractionId)
+	{
+		auto DockArea = qobject_cast<CDockAreaWidget*>(d->Content);
+		auto DockWidget = DockArea ? DockArea->currentDockWidget()
+			: qobject_cast<CDockWidget*>(d->Content);
+		QList<CDockWidget*> DockWidgets;
+		if (DockWidget)
+		{
+			DockWidgets.append(DockWidget);
+		}
+		d->InteractionId = d->DockManager->beginInteraction(DockWidgets);
+	}
 	resize(Size);
 	d->DragStartMousePosition = DragStartMousePos;
 	moveFloating();
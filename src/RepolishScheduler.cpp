@@ -0,0 +1,270 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   RepolishScheduler.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CRepolishScheduler class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "RepolishScheduler.h"
+
+#include <QApplication>
+#include <QEvent>
+#include <QHash>
+#include <QPointer>
+#include <QVector>
+#include <QWidget>
+
+namespace ads
+{
+static const QEvent::Type FlushEventType = static_cast<QEvent::Type>(QEvent::registerEventType());
+
+/**
+ * Pending repolish request
+ */
+struct RepolishRequest
+{
+	QPointer<QWidget> Widget;
+	internal::eRepolishChildOptions Options;
+};
+
+
+/**
+ * Private data class of CRepolishScheduler class (pimpl)
+ */
+struct RepolishSchedulerPrivate
+{
+	CRepolishScheduler* _this;
+	QHash<QWidget*, int> PendingIndex; ///< maps widget to index in Pending
+	QVector<RepolishRequest> Pending; ///< requests in scheduling order
+	bool FlushPosted = false;
+	int HoldCount = 0;
+	CRepolishScheduler::Counters Counters;
+
+	/**
+	 * Private data constructor
+	 */
+	RepolishSchedulerPrivate(CRepolishScheduler* _public) : _this(_public) {}
+};
+// struct RepolishSchedulerPrivate
+
+
+//============================================================================
+/**
+ * Returns true, if the repolish of the given widget is already done by
+ * the pending repolish of one of its ancestors
+ */
+static bool isCoveredByAncestor(QWidget* Widget, internal::eRepolishChildOptions Options,
+	const QVector<RepolishRequest>& Pending, const QHash<QWidget*, int>& PendingIndex)
+{
+	bool DirectParent = true;
+	for (auto Parent = Widget->parentWidget(); Parent; Parent = Parent->parentWidget())
+	{
+		auto it = PendingIndex.constFind(Parent);
+		if (it != PendingIndex.constEnd() && Pending[it.value()].Widget)
+		{
+			auto ParentOptions = Pending[it.value()].Options;
+			if (internal::RepolishChildrenRecursively == ParentOptions)
+			{
+				return true;
+			}
+
+			// The parent only repolishes its direct children, so the children
+			// of this widget are not covered
+			if (DirectParent && internal::RepolishDirectChildren == ParentOptions
+			 && internal::RepolishIgnoreChildren == Options)
+			{
+				return true;
+			}
+		}
+		DirectParent = false;
+	}
+
+	return false;
+}
+
+
+//============================================================================
+CRepolishScheduler::CRepolishScheduler(QObject* Parent) :
+	Super(Parent),
+	d(new RepolishSchedulerPrivate(this))
+{
+
+}
+
+
+//============================================================================
+CRepolishScheduler::~CRepolishScheduler()
+{
+	delete d;
+}
+
+
+//============================================================================
+CRepolishScheduler* CRepolishScheduler::instance()
+{
+	static QPointer<CRepolishScheduler> Instance;
+	if (!Instance)
+	{
+		Instance = new CRepolishScheduler(QApplication::instance());
+	}
+	return Instance;
+}
+
+
+//============================================================================
+void CRepolishScheduler::schedule(QWidget* Widget, internal::eRepolishChildOptions Options)
+{
+	if (!Widget)
+	{
+		return;
+	}
+
+	d->Counters.Requests++;
+	auto it = d->PendingIndex.find(Widget);
+	if (it != d->PendingIndex.end())
+	{
+		auto& Request = d->Pending[it.value()];
+		// A widget deleted since it was scheduled may have the same address
+		if (Request.Widget)
+		{
+			d->Counters.Duplicates++;
+		}
+		Request.Widget = Widget;
+		Request.Options = qMax(Request.Options, Options);
+	}
+	else
+	{
+		d->PendingIndex.insert(Widget, d->Pending.count());
+		d->Pending.append({Widget, Options});
+	}
+
+	if (!d->FlushPosted)
+	{
+		d->FlushPosted = true;
+		// High priority ensures, that the flush happens before the update
+		// requests of the widgets are processed
+		QApplication::postEvent(this, new QEvent(FlushEventType), Qt::HighEventPriority);
+	}
+}
+
+
+//============================================================================
+void CRepolishScheduler::flush()
+{
+	if (d->Pending.isEmpty())
+	{
+		return;
+	}
+
+	// Repolishing may schedule new requests - they will be handled by the
+	// next flush
+	QVector<RepolishRequest> Pending;
+	QHash<QWidget*, int> PendingIndex;
+	Pending.swap(d->Pending);
+	PendingIndex.swap(d->PendingIndex);
+	for (const auto& Request : Pending)
+	{
+		if (!Request.Widget)
+		{
+			continue;
+		}
+
+		if (isCoveredByAncestor(Request.Widget, Request.Options, Pending, PendingIndex))
+		{
+			d->Counters.Covered++;
+			continue;
+		}
+
+		internal::repolishStyleImmediately(Request.Widget, Request.Options);
+		d->Counters.Repolished++;
+	}
+	d->Counters.Flushes++;
+}
+
+
+//============================================================================
+bool CRepolishScheduler::event(QEvent* e)
+{
+	if (e->type() == FlushEventType)
+	{
+		d->FlushPosted = false;
+		if (!d->HoldCount)
+		{
+			flush();
+		}
+		return true;
+	}
+
+	return Super::event(e);
+}
+
+
+//============================================================================
+void CRepolishScheduler::hold()
+{
+	d->HoldCount++;
+}
+
+
+//============================================================================
+void CRepolishScheduler::release()
+{
+	if (d->HoldCount > 0 && 0 == --d->HoldCount)
+	{
+		flush();
+	}
+}
+
+
+//============================================================================
+bool CRepolishScheduler::isHolding() const
+{
+	return d->HoldCount > 0;
+}
+
+
+//============================================================================
+int CRepolishScheduler::pendingCount() const
+{
+	return d->Pending.count();
+}
+
+
+//============================================================================
+const CRepolishScheduler::Counters& CRepolishScheduler::counters() const
+{
+	return d->Counters;
+}
+
+
+//============================================================================
+void CRepolishScheduler::resetCounters()
+{
+	d->Counters = Counters();
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF RepolishScheduler.cpp
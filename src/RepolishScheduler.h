@@ -0,0 +1,148 @@
+#ifndef RepolishSchedulerH
+#define RepolishSchedulerH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   RepolishScheduler.h
+/// \date   18.10.2026
+/// \brief  Declaration of CRepolishScheduler class
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QObject>
+
+#include "ads_globals.h"
+
+namespace ads
+{
+struct RepolishSchedulerPrivate;
+
+/**
+ * Collects stylesheet repolish requests and executes them once per event
+ * loop iteration.
+ * A single user action like a drop or a perspective switch may request a
+ * repolish of the same widget many times. The scheduler merges duplicate
+ * requests and skips requests for widgets that are already covered by the
+ * repolish of one of their ancestors. The pending requests are flushed by a
+ * high priority posted event, that means before the next paint event is
+ * processed.
+ * The scheduler is used by internal::repolishStyle() if the
+ * CDockManager::DeferredRepolish performance flag is set or while an update
+ * transaction of a dock manager holds the scheduler.
+ */
+class ADS_EXPORT CRepolishScheduler : public QObject
+{
+	Q_OBJECT
+private:
+	RepolishSchedulerPrivate* d; ///< private data (pimpl)
+	friend struct RepolishSchedulerPrivate;
+
+protected:
+	/**
+	 * Handles the posted flush event
+	 */
+	virtual bool event(QEvent* e) override;
+
+public:
+	using Super = QObject;
+
+	/**
+	 * Counters for monitoring the efficiency of the scheduler
+	 */
+	struct Counters
+	{
+		quint64 Requests = 0; ///< number of scheduled repolish requests
+		quint64 Duplicates = 0; ///< requests merged into an already pending request
+		quint64 Covered = 0; ///< requests skipped because an ancestor repolish covers them
+		quint64 Repolished = 0; ///< number of executed repolish calls
+		quint64 Flushes = 0; ///< number of flushes that executed pending requests
+
+		/**
+		 * Number of repolish calls that have been saved by the scheduler
+		 */
+		quint64 saved() const {return Duplicates + Covered;}
+	};
+
+	/**
+	 * Default Constructor
+	 */
+	CRepolishScheduler(QObject* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CRepolishScheduler();
+
+	/**
+	 * Returns the global scheduler instance
+	 */
+	static CRepolishScheduler* instance();
+
+	/**
+	 * Records the given widget for a repolish with the given child options.
+	 * If the widget is already pending, the child options are merged.
+	 */
+	void schedule(QWidget* Widget, internal::eRepolishChildOptions Options);
+
+	/**
+	 * Executes all pending repolish requests immediately
+	 */
+	void flush();
+
+	/**
+	 * Suspends flushing until release() is called as often as hold().
+	 * Used by update transactions of the dock manager to defer all
+	 * repolish requests until the transaction ends
+	 */
+	void hold();
+
+	/**
+	 * Reverts one hold() call and flushes the pending requests if no hold
+	 * is left
+	 */
+	void release();
+
+	/**
+	 * Returns true, if flushing is suspended by hold()
+	 */
+	bool isHolding() const;
+
+	/**
+	 * Returns the number of pending requests
+	 */
+	int pendingCount() const;
+
+	/**
+	 * Returns the current counter values
+	 */
+	const Counters& counters() const;
+
+	/**
+	 * Resets all counters to 0
+	 */
+	void resetCounters();
+}; // class CRepolishScheduler
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // RepolishSchedulerH
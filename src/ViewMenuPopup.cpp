@@ -0,0 +1,244 @@
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   ViewMenuPopup.cpp
+/// \date   18.10.2026
+/// \brief  Implementation of CViewMenuModel and CViewMenuPopup classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include "ViewMenuPopup.h"
+
+#include <QAction>
+#include <QHash>
+#include <QLineEdit>
+#include <QListView>
+#include <QSortFilterProxyModel>
+#include <QVector>
+
+namespace ads
+{
+/**
+ * Private data class of CViewMenuModel class (pimpl)
+ */
+struct ViewMenuModelPrivate
+{
+	CViewMenuModel* _this;
+	QVector<QAction*> Actions;
+	QVector<QString> Groups;
+	QHash<QAction*, int> Rows;
+
+	/**
+	 * Private data constructor
+	 */
+	ViewMenuModelPrivate(CViewMenuModel* _public) : _this(_public) {}
+};
+// struct ViewMenuModelPrivate
+
+
+//============================================================================
+CViewMenuModel::CViewMenuModel(QObject* Parent) :
+	Super(Parent),
+	d(new ViewMenuModelPrivate(this))
+{
+
+}
+
+
+//============================================================================
+CViewMenuModel::~CViewMenuModel()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CViewMenuModel::addActions(const QList<QAction*>& Actions, const QString& Group)
+{
+	// Actions that are already in the model are skipped
+	int First = d->Actions.count();
+	QList<QAction*> NewActions;
+	for (auto Action : Actions)
+	{
+		if (!d->Rows.contains(Action))
+		{
+			d->Rows.insert(Action, First + NewActions.count());
+			NewActions.append(Action);
+		}
+	}
+	if (NewActions.isEmpty())
+	{
+		return;
+	}
+
+	beginInsertRows(QModelIndex(), First, First + NewActions.count() - 1);
+	for (auto Action : NewActions)
+	{
+		d->Actions.append(Action);
+		d->Groups.append(Group);
+		connect(Action, SIGNAL(changed()), SLOT(onActionChanged()));
+		connect(Action, SIGNAL(destroyed(QObject*)), SLOT(onActionDestroyed(QObject*)));
+	}
+	endInsertRows();
+}
+
+
+//============================================================================
+QAction* CViewMenuModel::action(int Row) const
+{
+	return (Row >= 0 && Row < d->Actions.count()) ? d->Actions.at(Row) : nullptr;
+}
+
+
+//============================================================================
+void CViewMenuModel::onActionChanged()
+{
+	int Row = d->Rows.value(qobject_cast<QAction*>(sender()), -1);
+	if (Row >= 0)
+	{
+		auto Index = index(Row);
+		emit dataChanged(Index, Index);
+	}
+}
+
+
+//============================================================================
+void CViewMenuModel::onActionDestroyed(QObject* Action)
+{
+	// The action is already destroyed, so only its address is compared
+	int Row = d->Rows.value(static_cast<QAction*>(Action), -1);
+	if (Row < 0)
+	{
+		return;
+	}
+
+	beginRemoveRows(QModelIndex(), Row, Row);
+	d->Actions.remove(Row);
+	d->Groups.remove(Row);
+	d->Rows.remove(static_cast<QAction*>(Action));
+	for (int i = Row; i < d->Actions.count(); ++i)
+	{
+		d->Rows[d->Actions[i]] = i;
+	}
+	endRemoveRows();
+}
+
+
+//============================================================================
+int CViewMenuModel::rowCount(const QModelIndex& Parent) const
+{
+	return Parent.isValid() ? 0 : d->Actions.count();
+}
+
+
+//============================================================================
+QVariant CViewMenuModel::data(const QModelIndex& Index, int Role) const
+{
+	auto Action = action(Index.row());
+	if (!Action)
+	{
+		return QVariant();
+	}
+
+	switch (Role)
+	{
+	case Qt::DisplayRole: return Action->text();
+	case Qt::DecorationRole: return Action->icon();
+	case Qt::ToolTipRole: return d->Groups.at(Index.row());
+	case Qt::CheckStateRole:
+		 if (!Action->isCheckable())
+		 {
+			 return QVariant();
+		 }
+		 return Action->isChecked() ? Qt::Checked : Qt::Unchecked;
+	case GroupRole: return d->Groups.at(Index.row());
+	default:
+		break;
+	}
+
+	return QVariant();
+}
+
+
+/**
+ * Private data class of CViewMenuPopup class (pimpl)
+ */
+struct ViewMenuPopupPrivate
+{
+	CViewMenuPopup* _this;
+	CViewMenuModel* Model;
+
+	/**
+	 * Private data constructor
+	 */
+	ViewMenuPopupPrivate(CViewMenuPopup* _public) : _this(_public) {}
+};
+// struct ViewMenuPopupPrivate
+
+
+//============================================================================
+CViewMenuPopup::CViewMenuPopup(CViewMenuModel* Model, bool Sorted, QWidget* Parent) :
+	Super(new QSortFilterProxyModel(), Parent),
+	d(new ViewMenuPopupPrivate(this))
+{
+	setObjectName("viewMenuPopup");
+	filterEdit()->setObjectName("viewMenuPopupFilterEdit");
+	filterEdit()->setPlaceholderText(tr("Filter views"));
+	listView()->setObjectName("viewMenuPopupListView");
+	d->Model = Model;
+	proxyModel()->setSortCaseSensitivity(Qt::CaseInsensitive);
+	proxyModel()->setSourceModel(Model);
+	if (Sorted)
+	{
+		proxyModel()->sort(0);
+	}
+}
+
+
+//============================================================================
+CViewMenuPopup::~CViewMenuPopup()
+{
+	delete d;
+}
+
+
+//============================================================================
+void CViewMenuPopup::popup(const QPoint& GlobalPos)
+{
+	showPopup(GlobalPos, 300, 20);
+}
+
+
+//============================================================================
+void CViewMenuPopup::activateRow(int SourceRow)
+{
+	auto Action = d->Model->action(SourceRow);
+	if (Action)
+	{
+		Action->trigger();
+	}
+}
+} // namespace ads
+
+//---------------------------------------------------------------------------
+// EOF ViewMenuPopup.cpp
@@ -0,0 +1,140 @@
+#ifndef ViewMenuPopupH
+#define ViewMenuPopupH
+/*******************************************************************************
+** Qt Advanced Docking System
+** Copyright (C) 2017 Uwe Kindler
+**
+** This library is free software; you can redistribute it and/or
+** modify it under the terms of the GNU Lesser General Public
+** License as published by the Free Software Foundation; either
+** version 2.1 of the License, or (at your option) any later version.
+**
+** This library is distributed in the hope that it will be useful,
+** but WITHOUT ANY WARRANTY; without even the implied warranty of
+** MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+** Lesser General Public License for more details.
+**
+** You should have received a copy of the GNU Lesser General Public
+** License along with this library; If not, see <http://www.gnu.org/licenses/>.
+******************************************************************************/
+
+
+//============================================================================
+/// \file   ViewMenuPopup.h
+/// \date   18.10.2026
+/// \brief  Declaration of CViewMenuModel and CViewMenuPopup classes
+//============================================================================
+
+
+//============================================================================
+//                                   INCLUDES
+//============================================================================
+#include <QAbstractListModel>
+
+#include "FilterPopup.h"
+
+class QAction;
+
+namespace ads
+{
+struct ViewMenuModelPrivate;
+struct ViewMenuPopupPrivate;
+
+/**
+ * List model over all toggle view actions that have been added to the view
+ * menu of the dock manager.
+ * The model only stores action pointers and queries text, icon and check
+ * state from the action when a view asks for it.
+ */
+class ADS_EXPORT CViewMenuModel : public QAbstractListModel
+{
+	Q_OBJECT
+private:
+	ViewMenuModelPrivate* d; ///< private data (pimpl)
+	friend struct ViewMenuModelPrivate;
+
+private slots:
+	void onActionChanged();
+	void onActionDestroyed(QObject* Action);
+
+public:
+	using Super = QAbstractListModel;
+
+	/**
+	 * Custom item data roles
+	 */
+	enum eRole
+	{
+		GroupRole = Qt::UserRole + 1 ///< view menu group of the action
+	};
+
+	/**
+	 * Default Constructor
+	 */
+	CViewMenuModel(QObject* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CViewMenuModel();
+
+	/**
+	 * Appends the given actions of the given view menu group in one
+	 * insertion
+	 */
+	void addActions(const QList<QAction*>& Actions, const QString& Group = QString());
+
+	/**
+	 * Returns the action for the given row or a nullptr if the row is invalid
+	 */
+	QAction* action(int Row) const;
+
+public: // reimplements QAbstractListModel ------------------------------------
+	virtual int rowCount(const QModelIndex& Parent = QModelIndex()) const override;
+	virtual QVariant data(const QModelIndex& Index, int Role = Qt::DisplayRole) const override;
+}; // class CViewMenuModel
+
+
+/**
+ * Filterable popup that lists all toggle view actions of the view menu.
+ * For applications with hundreds or thousands of dock widgets the popup is
+ * a faster alternative to browsing the view menu. Activating a row triggers
+ * the action.
+ */
+class ADS_EXPORT CViewMenuPopup : public CFilterPopup
+{
+	Q_OBJECT
+private:
+	ViewMenuPopupPrivate* d; ///< private data (pimpl)
+	friend struct ViewMenuPopupPrivate;
+
+protected:
+	/**
+	 * Triggers the action of the given row
+	 */
+	virtual void activateRow(int SourceRow) override;
+
+public:
+	using Super = CFilterPopup;
+
+	/**
+	 * Creates a popup for the given model.
+	 * If Sorted is true, the actions are listed in alphabetical order
+	 */
+	CViewMenuPopup(CViewMenuModel* Model, bool Sorted, QWidget* Parent = nullptr);
+
+	/**
+	 * Virtual Destructor
+	 */
+	virtual ~CViewMenuPopup();
+
+	/**
+	 * Clears the filter and shows the popup with its top left corner at the
+	 * given global position
+	 */
+	void popup(const QPoint& GlobalPos);
+}; // class CViewMenuPopup
+} // namespace ads
+
+//---------------------------------------------------------------------------
+#endif // ViewMenuPopupH
@@ -35,6 +35,8 @@
 
 #include "DockSplitter.h"
 #include "DockManager.h"
+#include "DockStyle.h"
+#include "RepolishScheduler.h"
 #include "IconProvider.h"
 #include "ads_globals.h"
 
@@ -54,7 +56,78 @@ namespace internal
 {
 #ifdef Q_OS_LINUX
 static QString _window_manager;
+static bool _window_manager_detected = false;
 static QHash<QString, xcb_atom_t> _xcb_atom_cache;
+static const char* const _xcb_atom_names[XcbAtomCount] =
+{
+	"_NET_WM_STATE",
+	"_NET_WM_STATE_ABOVE",
+	"_NET_WM_STATE_STAYS_ON_TOP",
+	"_NET_WM_STATE_SKIP_TASKBAR",
+	"_NET_WM_STATE_SKIP_PAGER",
+	"_NET_SUPPORTING_WM_CHECK",
+	"_WIN_SUPPORTING_WM_CHECK",
+	"_NET_WM_NAME",
+	"UTF8_STRING"
+};
+static xcb_intern_atom_cookie_t _xcb_atom_cookies[XcbAtomCount];
+static xcb_atom_t _xcb_atoms[XcbAtomCount];
+static bool _xcb_atoms_requested = false;
+static bool _xcb_atoms_resolved = false;
+
+
+//============================================================================
+void xcb_intern_atoms()
+{
+	if (_xcb_atoms_requested || !QX11Info::isPlatformX11())
+	{
+		return;
+	}
+
+	xcb_connection_t *connection = QX11Info::connection();
+	for (int i = 0; i < XcbAtomCount; ++i)
+	{
+		const char* name = _xcb_atom_names[i];
+		_xcb_atom_cookies[i] = xcb_intern_atom(connection, 1, strlen(name), name);
+	}
+	_xcb_atoms_requested = true;
+}
+
+
+//============================================================================
+xcb_atom_t xcb_atom(eXcbAtom Atom)
+{
+	if (Atom < 0 || Atom >= XcbAtomCount)
+	{
+		return XCB_ATOM_NONE;
+	}
+
+	if (!_xcb_atoms_resolved)
+	{
+		if (!QX11Info::isPlatformX11())
+		{
+			return XCB_ATOM_NONE;
+		}
+
+		// All requests have been sent in one go, so collecting the replies
+		// costs at most one round trip to the X server
+		xcb_intern_atoms();
+		xcb_connection_t *connection = QX11Info::connection();
+		for (int i = 0; i < XcbAtomCount; ++i)
+		{
+			auto reply = xcb_intern_atom_reply(connection, _xcb_atom_cookies[i], nullptr);
+			_xcb_atoms[i] = reply ? reply->atom : XCB_ATOM_NONE;
+			if (_xcb_atoms[i] == XCB_ATOM_NONE)
+			{
+				ADS_PRINT("Unknown Atom response from XServer: " << _xcb_atom_names[i]);
+			}
+			free(reply);
+		}
+		_xcb_atoms_resolved = true;
+	}
+
+	return _xcb_atoms[Atom];
+}
 
 
 //============================================================================
@@ -64,6 +137,13 @@ xcb_atom_t xcb_get_atom(const char *name)
 	{
 		return XCB_ATOM_NONE;
 	}
+	for (int i = 0; i < XcbAtomCount; ++i)
+	{
+		if (strcmp(name, _xcb_atom_names[i]) == 0)
+		{
+			return xcb_atom(static_cast<eXcbAtom>(i));
+		}
+	}
 	auto key = QString(name);
 	if(_xcb_atom_cache.contains(key))
 	{
@@ -115,6 +195,38 @@ void xcb_update_prop(bool set, WId window, const char *type, const char *prop, c
 }
 
 
+//============================================================================
+void xcb_update_prop(bool set, const QVector<WId>& windows, eXcbAtom type,
+	eXcbAtom prop, eXcbAtom prop2)
+{
+	if (windows.isEmpty() || !QX11Info::isPlatformX11())
+	{
+		return;
+	}
+
+	auto connection = QX11Info::connection();
+	xcb_client_message_event_t event;
+	event.response_type = XCB_CLIENT_MESSAGE;
+	event.format = 32;
+	event.sequence = 0;
+	event.type = xcb_atom(type);
+	event.data.data32[0] = set ? 1 : 0;
+	event.data.data32[1] = xcb_atom(prop);
+	event.data.data32[2] = (prop2 != XcbAtomCount) ? xcb_atom(prop2) : 0;
+	event.data.data32[3] = 0;
+	event.data.data32[4] = 0;
+
+	for (auto window : windows)
+	{
+		event.window = window;
+		xcb_send_event(connection, 0, window,
+					   XCB_EVENT_MASK_STRUCTURE_NOTIFY | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT | XCB_EVENT_MASK_PROPERTY_CHANGE,
+					   (const char *)&event);
+	}
+	xcb_flush(connection);
+}
+
+
 //============================================================================
 xcb_get_property_reply_t* _xcb_get_props(WId window, const char *type, unsigned int atom_type)
 {
@@ -278,9 +390,10 @@ QString detectWindowManagerX11()
 //============================================================================
 QString windowManager()
 {
-	if(_window_manager.length() == 0)
+	if (!_window_manager_detected)
 	{
 		_window_manager = detectWindowManagerX11();
+		_window_manager_detected = true;
 	}
 	return _window_manager;
 }
@@ -333,7 +446,7 @@ void hideEmptyParentSplitters(CDockSplitter* Splitter)
 		{
 			Splitter->hide();
 		}
-		Splitter = internal::findParent<CDockSplitter*>(Splitter);
+		Splitter = internal::parentSplitter<CDockSplitter*>(Splitter);
 	}
 }
 
@@ -370,6 +483,35 @@ void repolishStyle(QWidget* w, eRepolishChildOptions Options)
 	{
 		return;
 	}
+
+	// The dock style reads the widget state while painting, so there is
+	// no need to reevaluate any stylesheet
+	auto DockStyle = qobject_cast<CDockStyle*>(w->style());
+	if (DockStyle)
+	{
+		DockStyle->updateWidgetState(w);
+		return;
+	}
+
+	if (CDockManager::testPerformanceFlag(CDockManager::DeferredRepolish)
+	 || CRepolishScheduler::instance()->isHolding())
+	{
+		CRepolishScheduler::instance()->schedule(w, Options);
+		return;
+	}
+
+	repolishStyleImmediately(w, Options);
+}
+
+
+//============================================================================
+void repolishStyleImmediately(QWidget* w, eRepolishChildOptions Options)
+{
+	if (!w)
+	{
+		return;
+	}
+
 	w->style()->unpolish(w);
 	w->style()->polish(w);
 
@@ -31,6 +31,7 @@
 //                                   INCLUDES
 //============================================================================
 #include <QPair>
+#include <QVector>
 #include <QtCore/QtGlobal>
 #include <QPixmap>
 #include <QWidget>
@@ -132,11 +133,41 @@ namespace internal
 {
 static const bool RestoreTesting = true;
 static const bool Restore = false;
-static const char* const ClosedProperty = "close";
-static const char* const DirtyProperty = "dirty";
 
 #ifdef Q_OS_LINUX
+/**
+ * The X11 atoms used by the docking system. The atoms are interned once
+ * and cached in a static array indexed by this enum
+ */
+enum eXcbAtom
+{
+	XcbAtomNetWmState,           //!< _NET_WM_STATE
+	XcbAtomNetWmStateAbove,      //!< _NET_WM_STATE_ABOVE
+	XcbAtomNetWmStateStaysOnTop, //!< _NET_WM_STATE_STAYS_ON_TOP
+	XcbAtomNetWmStateSkipTaskbar,//!< _NET_WM_STATE_SKIP_TASKBAR
+	XcbAtomNetWmStateSkipPager,  //!< _NET_WM_STATE_SKIP_PAGER
+	XcbAtomNetSupportingWmCheck, //!< _NET_SUPPORTING_WM_CHECK
+	XcbAtomWinSupportingWmCheck, //!< _WIN_SUPPORTING_WM_CHECK
+	XcbAtomNetWmName,            //!< _NET_WM_NAME
+	XcbAtomUtf8String,           //!< UTF8_STRING
+
+	XcbAtomCount,                //!< just a delimiter for range checks
+};
+
 // Utils to directly communicate with the X server
+/**
+ * Sends the intern atom requests for all atoms in eXcbAtom to the X server
+ * without waiting for the replies. The replies are collected on the first
+ * call of xcb_atom(). Call this function as early as possible, so that the
+ * replies are already available when the atoms are needed.
+ */
+void xcb_intern_atoms();
+
+/**
+ * Returns the given atom from the static atom cache
+ */
+xcb_atom_t xcb_atom(eXcbAtom Atom);
+
 /**
  * Get atom from cache or request it from the XServer.
  */
@@ -150,6 +181,13 @@ void xcb_add_prop(bool state, WId window, const char *type, const char *prop);
  * Updates up to two window properties. Can be set on a visible window.
  */
 void xcb_update_prop(bool set, WId window, const char *type, const char *prop, const char *prop2 = nullptr);
+/**
+ * Updates up to two window properties of all given windows. The client
+ * messages for all windows are sent with a single flush of the connection.
+ * Pass XcbAtomCount as prop2 to update only one property.
+ */
+void xcb_update_prop(bool set, const QVector<WId>& windows, eXcbAtom type,
+	eXcbAtom prop, eXcbAtom prop2 = XcbAtomCount);
 /**
  * Only for debugging purposes.
  */
@@ -216,6 +254,19 @@ T findParent(const QWidget* w)
 	return 0;
 }
 
+/**
+ * Returns the parent widget of the given widget if it is a splitter of type
+ * T or 0 otherwise.
+ * Dock areas and splitters are always direct children of the splitter that
+ * contains them, so this function replaces findParent<T>() for them without
+ * walking the parent chain.
+ */
+template <class T>
+T parentSplitter(const QWidget* w)
+{
+	return qobject_cast<T>(w->parentWidget());
+}
+
 /**
  * Creates a semi transparent pixmap from the given pixmap Source.
  * The Opacity parameter defines the opacity from completely transparent (0.0)
@@ -287,10 +338,17 @@ enum eRepolishChildOptions
 
 /**
  * Calls unpolish() / polish for the style of the given widget to update
- * stylesheet if a property changes
+ * stylesheet if a property changes.
+ * If the CDockManager::DeferredRepolish performance flag is set, the
+ * repolish is scheduled and executed by the CRepolishScheduler
  */
 void repolishStyle(QWidget* w, eRepolishChildOptions Options = RepolishIgnoreChildren);
 
+/**
+ * Calls unpolish() / polish for the style of the given widget immediately
+ */
+void repolishStyleImmediately(QWidget* w, eRepolishChildOptions Options = RepolishIgnoreChildren);
+
 
 } // namespace internal
 } // namespace ads
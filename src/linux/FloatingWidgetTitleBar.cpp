@@ -40,6 +40,7 @@
 #include "ads_globals.h"
 #include "ElidingLabel.h"
 #include "FloatingDockContainer.h"
+#include "DockStyle.h"
 
 namespace ads
 {
@@ -136,6 +137,7 @@ CFloatingWidgetTitleBar::CFloatingWidgetTitleBar(CFloatingDockContainer *parent)
 {
 	d->FloatingWidget = parent;
 	d->createLayout();
+	CDockStyle::applyTo(this, true);
 
     auto normalPixmap = this->style()->standardPixmap(QStyle::SP_TitleBarNormalButton, 0, d->MaximizeButton);
     d->NormalIcon.addPixmap(normalPixmap, QIcon::Normal);
@@ -170,8 +172,11 @@ void CFloatingWidgetTitleBar::mousePressEvent(QMouseEvent *ev)
 //============================================================================
 void CFloatingWidgetTitleBar::mouseReleaseEvent(QMouseEvent *ev)
 {
+	// If the drag has been handed over to the window manager, the floating
+	// widget detects the release itself
+	bool WasDragging = (d->DragState != DraggingInactive);
 	d->DragState = DraggingInactive;
-    if (d->FloatingWidget)
+    if (d->FloatingWidget && WasDragging)
     {
 		d->FloatingWidget->finishDragging();
     }
@@ -196,6 +201,12 @@ void CFloatingWidgetTitleBar::mouseMoveEvent(QMouseEvent *ev)
 		{
 			d->FloatingWidget->showNormal(true);
 		}
+		if (d->FloatingWidget->startSystemMove())
+		{
+			d->DragState = DraggingInactive;
+			Super::mouseMoveEvent(ev);
+			return;
+		}
 		d->FloatingWidget->moveFloating();
 		Super::mouseMoveEvent(ev);
 		return;
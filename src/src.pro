@@ -32,19 +32,27 @@ HEADERS += \
     ads_globals.h \
     DockAreaWidget.h \
     DockAreaTabBar.h \
+    DockAreaTabsPopup.h \
     DockContainerWidget.h \
+    DockFlatLayout.h \
+    DockLayout.h \
     DockManager.h \
     DockWidget.h \
+    DockWidgetRegistry.h \
     DockWidgetTab.h \ 
     DockingStateReader.h \
     FloatingDockContainer.h \
     FloatingDragPreview.h \
     DockOverlay.h \
     DockSplitter.h \
+    DockStyle.h \
     DockAreaTitleBar_p.h \
     DockAreaTitleBar.h \
     ElidingLabel.h \
+    FilterPopup.h \
     IconProvider.h \
+    RepolishScheduler.h \
+    ViewMenuPopup.h \
     DockComponentsFactory.h  \
     DockFocusController.h
 
@@ -53,18 +61,26 @@ SOURCES += \
     ads_globals.cpp \
     DockAreaWidget.cpp \
     DockAreaTabBar.cpp \
+    DockAreaTabsPopup.cpp \
     DockContainerWidget.cpp \
+    DockFlatLayout.cpp \
+    DockLayout.cpp \
     DockManager.cpp \
     DockWidget.cpp \
+    DockWidgetRegistry.cpp \
     DockingStateReader.cpp \
     DockWidgetTab.cpp \
     FloatingDockContainer.cpp \
     FloatingDragPreview.cpp \
     DockOverlay.cpp \
     DockSplitter.cpp \
+    DockStyle.cpp \
     DockAreaTitleBar.cpp \
     ElidingLabel.cpp \
+    FilterPopup.cpp \
     IconProvider.cpp \
+    RepolishScheduler.cpp \
+    ViewMenuPopup.cpp \
     DockComponentsFactory.cpp \
     DockFocusController.cpp
 